@@ -0,0 +1,178 @@
+#include <GLCore/Core/Log.h>
+#include <GLCore/Core/AssetPack.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace GLCore;
+namespace fs = std::filesystem;
+
+// Usage: OpenGL-AssetPacker <output .pak> <input file|dir>... [--force]
+//
+// Packs every file below the inputs into one archive for AssetPack::Mount().
+// Entries are named by their path as given (relative to the working
+// directory), which is how the application asks for them. The pack is only
+// rebuilt when an input file or directory is newer than it.
+
+struct PackInput
+{
+	std::string Name;
+	fs::path Path;
+};
+
+static bool IsUpToDate(const fs::path& output, const std::vector<PackInput>& inputs, const std::vector<fs::path>& directories)
+{
+	std::error_code error;
+	fs::file_time_type packTime = fs::last_write_time(output, error);
+	if (error)
+		return false;
+
+	// Directory times catch files that were removed
+	for (const PackInput& input : inputs)
+	{
+		if (fs::last_write_time(input.Path, error) > packTime)
+			return false;
+	}
+	for (const fs::path& directory : directories)
+	{
+		if (fs::last_write_time(directory, error) > packTime)
+			return false;
+	}
+	return true;
+}
+
+static bool ReadFile(const fs::path& path, std::vector<char>& data)
+{
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	if (!stream)
+		return false;
+
+	data.resize((size_t)stream.tellg());
+	stream.seekg(0);
+	stream.read(data.data(), data.size());
+	return (bool)stream;
+}
+
+static bool WritePack(const fs::path& output, const std::vector<PackInput>& inputs)
+{
+	AssetPackHeader header;
+	header.EntryCount = (uint32_t)inputs.size();
+
+	std::vector<AssetPackEntry> entries(inputs.size());
+	std::string names;
+	for (size_t i = 0; i < inputs.size(); i++)
+	{
+		entries[i].NameOffset = (uint32_t)names.size();
+		entries[i].NameLength = (uint32_t)inputs[i].Name.size();
+		names += inputs[i].Name;
+	}
+	header.NamesSize = (uint32_t)names.size();
+
+	std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		LOG_ERROR("Could not open '{0}' for writing", output.string());
+		return false;
+	}
+
+	// The table is written again once the blob offsets are known
+	stream.write((const char*)&header, sizeof(header));
+	stream.write((const char*)entries.data(), entries.size() * sizeof(AssetPackEntry));
+	stream.write(names.data(), names.size());
+
+	std::vector<char> data;
+	for (size_t i = 0; i < inputs.size(); i++)
+	{
+		if (!ReadFile(inputs[i].Path, data))
+		{
+			LOG_ERROR("Could not read '{0}'", inputs[i].Path.string());
+			return false;
+		}
+
+		static const char s_Padding[AssetPackHeader::Alignment] = {};
+		uint64_t position = (uint64_t)stream.tellp();
+		uint64_t offset = (position + AssetPackHeader::Alignment - 1) & ~(uint64_t)(AssetPackHeader::Alignment - 1);
+		stream.write(s_Padding, offset - position);
+		stream.write(data.data(), data.size());
+
+		entries[i].Offset = offset;
+		entries[i].Size = data.size();
+	}
+
+	stream.seekp(sizeof(header));
+	stream.write((const char*)entries.data(), entries.size() * sizeof(AssetPackEntry));
+
+	if (!stream)
+	{
+		LOG_ERROR("Could not write '{0}'", output.string());
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	GLCore::Log::Init();
+
+	bool force = false;
+	std::vector<const char*> paths;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--force") == 0)
+			force = true;
+		else
+			paths.push_back(argv[i]);
+	}
+
+	if (paths.size() < 2)
+	{
+		LOG_ERROR("Usage: OpenGL-AssetPacker <output .pak> <input file|dir>... [--force]");
+		return 1;
+	}
+
+	const fs::path output = paths[0];
+
+	std::vector<PackInput> inputs;
+	std::vector<fs::path> directories;
+	std::error_code error;
+	for (size_t i = 1; i < paths.size(); i++)
+	{
+		fs::path input = paths[i];
+		if (fs::is_directory(input, error))
+		{
+			directories.push_back(input);
+			for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error))
+			{
+				if (entry.is_directory())
+					directories.push_back(entry.path());
+				else if (entry.is_regular_file())
+					inputs.push_back({ AssetPack::NormalizePath(entry.path().string()), entry.path() });
+			}
+		}
+		else if (fs::is_regular_file(input, error))
+			inputs.push_back({ AssetPack::NormalizePath(input.string()), input });
+		else
+			LOG_WARN("'{0}' does not exist, skipping", input.string());
+	}
+
+	// Sorted for the binary search at runtime; the same file given twice is packed once
+	std::sort(inputs.begin(), inputs.end(), [](const PackInput& a, const PackInput& b) { return a.Name < b.Name; });
+	inputs.erase(std::unique(inputs.begin(), inputs.end(), [](const PackInput& a, const PackInput& b) { return a.Name == b.Name; }), inputs.end());
+
+	if (!force && IsUpToDate(output, inputs, directories))
+	{
+		LOG_TRACE("{0} is up to date", output.string());
+		return 0;
+	}
+
+	if (!WritePack(output, inputs))
+	{
+		fs::remove(output, error);
+		return 1;
+	}
+
+	LOG_INFO("{0}: {1} assets, {2} KB", output.string(), inputs.size(), fs::file_size(output, error) / 1024);
+	return 0;
+}
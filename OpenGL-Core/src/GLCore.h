@@ -8,4 +8,16 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <imgui.h>
 
-#include "GLCore/Core/Application.h"
\ No newline at end of file
+#include "GLCore/Core/Application.h"
+#include "GLCore/Core/AssetPack.h"
+#include "GLCore/Core/FileWatcher.h"
+#include "GLCore/Renderer/Renderer2D.h"
+#include "GLCore/Renderer/Buffer.h"
+#include "GLCore/Renderer/VertexArray.h"
+#include "GLCore/Renderer/RenderQueue.h"
+#include "GLCore/Renderer/MultiDrawIndirect.h"
+#include "GLCore/Renderer/GLStateCache.h"
+#include "GLCore/Renderer/TextureAtlas.h"
+#include "GLCore/Renderer/AsyncTextureLoader.h"
+#include "GLCore/Renderer/TextureLibrary.h"
+#include "GLCore/Renderer/UniformBuffer.h"
\ No newline at end of file
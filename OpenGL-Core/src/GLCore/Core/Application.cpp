@@ -5,6 +5,15 @@
 
 #include "Input.h"
 
+#include "../Renderer/QuadKernel.h"
+#include "../Renderer/Renderer2D.h"
+#include "../Renderer/RenderQueue.h"
+#include "../Renderer/GLStateCache.h"
+#include "../Renderer/TextureLibrary.h"
+#include "../Renderer/UniformBuffer.h"
+#include "../Util/Shader.h"
+#include "../Util/ShaderHotReload.h"
+
 #include <glfw/glfw3.h>
 
 namespace GLCore {
@@ -24,15 +33,32 @@ namespace GLCore {
 		GLCORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 
+		// A few thousand sprites, cheap enough to run on every Debug start
+		GLCORE_ASSERT(VerifyQuadKernels(), "SIMD quad kernels disagree with the scalar path!");
+
 		m_Window = std::unique_ptr<Window>(Window::Create({ name, width, height }));
 		m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
 
-		// Renderer::Init();
+		GLStateCache::Init();
+		FrameUniforms::Init();
+		Renderer2D::Init();
+		RenderQueue::Init();
+		TextureLibrary::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
 	}
 
+	Application::~Application()
+	{
+		Utils::ShaderHotReload::Shutdown();
+		TextureLibrary::Shutdown();
+		RenderQueue::Shutdown();
+		Renderer2D::Shutdown();
+		Utils::Shader::ClearVariants();
+		FrameUniforms::Shutdown();
+	}
+
 	void Application::PushLayer(Layer* layer)
 	{
 		m_LayerStack.PushLayer(layer);
@@ -64,14 +90,25 @@ namespace GLCore {
 			Timestep timestep = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			GLStateCache::ResetStats();
+			FrameUniforms::ResetStats();
+
 			for (Layer* layer : m_LayerStack)
 				layer->OnUpdate(timestep);
+			RenderQueue::Flush();
+			FrameUniforms::EndFrame();
 
 			m_ImGuiLayer->Begin();
 			for (Layer* layer : m_LayerStack)
 				layer->OnImGuiRender();
 			m_ImGuiLayer->End();
 
+			// The ImGui backend binds its own program, buffers and textures
+			GLStateCache::Invalidate();
+
+			TextureLibrary::Update();
+			Utils::ShaderHotReload::Update();
+
 			m_Window->OnUpdate();
 		}
 	}
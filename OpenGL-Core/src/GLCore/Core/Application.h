@@ -17,7 +17,7 @@ namespace GLCore {
 	{
 	public:
 		Application(const std::string& name = "OpenGL Sandbox", uint32_t width = 1280, uint32_t height = 720);
-		virtual ~Application() = default;
+		virtual ~Application();
 
 		void Run();
 
@@ -0,0 +1,256 @@
+#include "glpch.h"
+#include "AssetPack.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#ifndef GLCORE_PLATFORM_WINDOWS
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace GLCore {
+
+	// Read-only view of a whole file
+	class MappedFile
+	{
+	public:
+		~MappedFile() { Close(); }
+
+		bool Open(const std::string& path)
+		{
+			Close();
+#ifdef GLCORE_PLATFORM_WINDOWS
+			HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER size;
+			HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0
+				? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+			CloseHandle(file);
+			if (!mapping)
+				return false;
+
+			// The view keeps the mapping alive
+			m_Data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			m_Size = m_Data ? (size_t)size.QuadPart : 0;
+#else
+			int file = open(path.c_str(), O_RDONLY);
+			if (file < 0)
+				return false;
+
+			struct stat status;
+			void* data = fstat(file, &status) == 0 && status.st_size > 0
+				? mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+			close(file);
+			if (data == MAP_FAILED)
+				return false;
+
+			m_Data = (const uint8_t*)data;
+			m_Size = (size_t)status.st_size;
+#endif
+			return m_Data != nullptr;
+		}
+
+		void Close()
+		{
+			if (!m_Data)
+				return;
+#ifdef GLCORE_PLATFORM_WINDOWS
+			UnmapViewOfFile(m_Data);
+#else
+			munmap((void*)m_Data, m_Size);
+#endif
+			m_Data = nullptr;
+			m_Size = 0;
+		}
+
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+
+	struct AssetPackData
+	{
+		MappedFile File;
+		const AssetPackEntry* Entries = nullptr;
+		const char* Names = nullptr;
+		uint32_t EntryCount = 0;
+
+		std::atomic<uint32_t> PackReads = 0;
+		std::atomic<uint32_t> LooseReads = 0;
+	};
+
+	static AssetPackData s_PackData;
+
+	static std::string_view GetEntryName(const AssetPackEntry& entry)
+	{
+		return { s_PackData.Names + entry.NameOffset, entry.NameLength };
+	}
+
+	// Offsets and names in bounds and names sorted, so lookups need no further checks
+	static bool ValidatePack(const std::string& path)
+	{
+		const uint8_t* data = s_PackData.File.GetData();
+		const size_t size = s_PackData.File.GetSize();
+
+		AssetPackHeader header;
+		if (size < sizeof(header))
+		{
+			LOG_ERROR("Asset pack '{0}' is truncated", path);
+			return false;
+		}
+		memcpy(&header, data, sizeof(header));
+
+		if (header.Magic != AssetPackHeader::ExpectedMagic || header.Version != AssetPackHeader::CurrentVersion)
+		{
+			LOG_ERROR("'{0}' is not a version {1} asset pack", path, AssetPackHeader::CurrentVersion);
+			return false;
+		}
+
+		const uint64_t namesOffset = sizeof(header) + (uint64_t)header.EntryCount * sizeof(AssetPackEntry);
+		if (namesOffset + header.NamesSize > size)
+		{
+			LOG_ERROR("Asset pack '{0}' is truncated", path);
+			return false;
+		}
+
+		s_PackData.Entries = (const AssetPackEntry*)(data + sizeof(header));
+		s_PackData.Names = (const char*)(data + namesOffset);
+		s_PackData.EntryCount = header.EntryCount;
+
+		for (uint32_t i = 0; i < header.EntryCount; i++)
+		{
+			const AssetPackEntry& entry = s_PackData.Entries[i];
+			bool valid = (uint64_t)entry.NameOffset + entry.NameLength <= header.NamesSize
+				&& entry.Offset <= size && entry.Size <= size - entry.Offset
+				&& (i == 0 || GetEntryName(s_PackData.Entries[i - 1]) < GetEntryName(entry));
+			if (!valid)
+			{
+				LOG_ERROR("Asset pack '{0}' entry {1} is corrupt", path, i);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool AssetPack::Mount(const std::string& path)
+	{
+		Unmount();
+
+		if (!s_PackData.File.Open(path))
+		{
+			LOG_WARN("Could not map asset pack '{0}', reading loose files", path);
+			return false;
+		}
+
+		if (!ValidatePack(path))
+		{
+			Unmount();
+			return false;
+		}
+
+		LOG_INFO("Mounted asset pack '{0}': {1} assets, {2} KB", path, s_PackData.EntryCount, s_PackData.File.GetSize() / 1024);
+		return true;
+	}
+
+	void AssetPack::Unmount()
+	{
+		s_PackData.File.Close();
+		s_PackData.Entries = nullptr;
+		s_PackData.Names = nullptr;
+		s_PackData.EntryCount = 0;
+	}
+
+	bool AssetPack::IsMounted()
+	{
+		return s_PackData.File.GetData() != nullptr;
+	}
+
+	std::string AssetPack::NormalizePath(const std::string& path)
+	{
+		std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+		if (normalized.rfind("./", 0) == 0)
+			normalized.erase(0, 2);
+		return normalized;
+	}
+
+	static const AssetPackEntry* FindEntry(const std::string& path)
+	{
+		if (!s_PackData.EntryCount)
+			return nullptr;
+
+		std::string name = AssetPack::NormalizePath(path);
+		const AssetPackEntry* end = s_PackData.Entries + s_PackData.EntryCount;
+		const AssetPackEntry* entry = std::lower_bound(s_PackData.Entries, end, name,
+			[](const AssetPackEntry& entry, const std::string& name) { return GetEntryName(entry) < name; });
+		return entry != end && GetEntryName(*entry) == name ? entry : nullptr;
+	}
+
+	AssetData AssetPack::Read(const std::string& path)
+	{
+		const AssetPackEntry* entry = FindEntry(path);
+		if (!entry)
+			return ReadFile(path);
+
+		s_PackData.PackReads++;
+
+		AssetData data;
+		data.m_Data = s_PackData.File.GetData() + entry->Offset;
+		data.m_Size = (size_t)entry->Size;
+		data.m_Mapped = true;
+		return data;
+	}
+
+	AssetData AssetPack::ReadFile(const std::string& path)
+	{
+		AssetData data;
+
+		std::ifstream in(path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!in)
+			return data;
+		s_PackData.LooseReads++;
+
+		data.m_Storage.resize((size_t)in.tellg());
+		in.seekg(0, std::ios::beg);
+		in.read((char*)data.m_Storage.data(), data.m_Storage.size());
+
+		// Empty files still count as found
+		static const uint8_t s_Empty = 0;
+		data.m_Data = data.m_Storage.empty() ? &s_Empty : data.m_Storage.data();
+		data.m_Size = data.m_Storage.size();
+		return data;
+	}
+
+	bool AssetPack::Contains(const std::string& path)
+	{
+		return FindEntry(path) != nullptr;
+	}
+
+	std::vector<std::string_view> AssetPack::GetEntryNames()
+	{
+		std::vector<std::string_view> names;
+		names.reserve(s_PackData.EntryCount);
+		for (uint32_t i = 0; i < s_PackData.EntryCount; i++)
+			names.push_back(GetEntryName(s_PackData.Entries[i]));
+		return names;
+	}
+
+	AssetPack::Statistics AssetPack::GetStats()
+	{
+		Statistics stats;
+		stats.EntryCount = s_PackData.EntryCount;
+		stats.MappedBytes = s_PackData.File.GetSize();
+		stats.PackReads = s_PackData.PackReads;
+		stats.LooseReads = s_PackData.LooseReads;
+		return stats;
+	}
+
+}
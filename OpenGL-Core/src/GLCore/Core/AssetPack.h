@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GLCore {
+
+	// A .pak file is this header, EntryCount entries sorted by name (plain byte
+	// order), the entry names back to back and the blobs, each starting on an
+	// Alignment boundary so cooked textures can be used in place.
+	struct AssetPackHeader
+	{
+		static constexpr uint32_t ExpectedMagic = 0x4b504c47; // "GLPK"
+		static constexpr uint32_t CurrentVersion = 1;
+		static constexpr uint32_t Alignment = 16;
+
+		uint32_t Magic = ExpectedMagic;
+		uint32_t Version = CurrentVersion;
+		uint32_t EntryCount = 0;
+		uint32_t NamesSize = 0;
+	};
+
+	struct AssetPackEntry
+	{
+		uint32_t NameOffset, NameLength; // into the names, which follow the entry table
+		uint64_t Offset;                 // from the start of the file
+		uint64_t Size;
+	};
+
+	static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader is part of the file format");
+	static_assert(sizeof(AssetPackEntry) == 24, "AssetPackEntry is part of the file format");
+
+	// Contents of one asset: a view into the mounted pack or, for loose files,
+	// a buffer it owns. Pack views stay valid until the pack is unmounted.
+	class AssetData
+	{
+	public:
+		AssetData() = default;
+		AssetData(AssetData&&) = default;
+		AssetData& operator=(AssetData&&) = default;
+
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+		std::string_view GetString() const { return { (const char*)m_Data, m_Size }; }
+
+		// Served from the pack without a copy
+		bool IsMapped() const { return m_Mapped; }
+
+		explicit operator bool() const { return m_Data != nullptr; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		bool m_Mapped = false;
+		std::vector<uint8_t> m_Storage;
+
+		friend class AssetPack;
+	};
+
+	// Read-only archive mapped into memory once, so a cold start does not pay
+	// for opening every shader and texture separately. Paths are looked up as
+	// the game passes them ("assets/shaders/x.glsl", normalized lexically);
+	// anything not in the pack, or every path while no pack is mounted, is
+	// read from the loose file instead, which is what development runs on.
+	// Build packs with the OpenGL-AssetPacker tool.
+	//
+	// Read() may be called from any thread; Mount() and Unmount() only while
+	// nothing else is reading.
+	class AssetPack
+	{
+	public:
+		// Replaces the mounted pack; returns false (and keeps loose files) if it cannot be opened
+		static bool Mount(const std::string& path);
+		static void Unmount();
+		static bool IsMounted();
+
+		// Pack first, then the loose file; empty if neither exists
+		static AssetData Read(const std::string& path);
+		// Always the loose file
+		static AssetData ReadFile(const std::string& path);
+
+		static bool Contains(const std::string& path);
+		static std::vector<std::string_view> GetEntryNames();
+
+		static std::string NormalizePath(const std::string& path);
+
+		struct Statistics
+		{
+			uint32_t EntryCount = 0;
+			uint64_t MappedBytes = 0;
+			uint32_t PackReads = 0;
+			uint32_t LooseReads = 0;
+		};
+		static Statistics GetStats();
+	};
+
+}
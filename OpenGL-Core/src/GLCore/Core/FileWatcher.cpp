@@ -0,0 +1,137 @@
+#include "glpch.h"
+#include "FileWatcher.h"
+
+#include "AssetPack.h"
+
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace GLCore {
+
+	FileWatcher::FileWatcher()
+	{
+#ifdef __linux__
+		m_NotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_NotifyDescriptor < 0)
+			LOG_WARN("inotify unavailable, falling back to polling for file changes");
+#endif
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+#ifdef __linux__
+		if (m_NotifyDescriptor >= 0)
+			close(m_NotifyDescriptor);
+#endif
+	}
+
+	bool FileWatcher::IsNative() const
+	{
+		return m_NotifyDescriptor >= 0;
+	}
+
+	bool FileWatcher::IsWatching(const std::string& directory) const
+	{
+		std::string path = AssetPack::NormalizePath(directory);
+		return std::any_of(m_Directories.begin(), m_Directories.end(), [&](const WatchedDirectory& watched) { return watched.Path == path; });
+	}
+
+	bool FileWatcher::Watch(const std::string& directory)
+	{
+		if (IsWatching(directory))
+			return true;
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error))
+			return false;
+
+		WatchedDirectory watched;
+		watched.Path = AssetPack::NormalizePath(directory);
+
+#ifdef __linux__
+		if (m_NotifyDescriptor >= 0)
+		{
+			// Editors either write in place or write a temporary and rename it over the file
+			watched.Descriptor = inotify_add_watch(m_NotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watched.Descriptor < 0)
+			{
+				LOG_WARN("Could not watch '{0}'", directory);
+				return false;
+			}
+		}
+#endif
+
+		if (watched.Descriptor < 0)
+			ScanDirectory(watched, nullptr);
+
+		m_Directories.push_back(std::move(watched));
+		return true;
+	}
+
+	void FileWatcher::ScanDirectory(WatchedDirectory& directory, std::vector<std::string>* changes)
+	{
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(directory.Path, error))
+		{
+			if (!entry.is_regular_file(error))
+				continue;
+
+			std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+			auto [it, inserted] = directory.WriteTimes.try_emplace(entry.path().filename().string(), writeTime);
+			if (!inserted && it->second == writeTime)
+				continue;
+
+			it->second = writeTime;
+			if (changes)
+				changes->push_back(AssetPack::NormalizePath(entry.path().string()));
+		}
+	}
+
+	std::vector<std::string> FileWatcher::Poll()
+	{
+		std::vector<std::string> changes;
+
+#ifdef __linux__
+		if (m_NotifyDescriptor >= 0)
+		{
+			alignas(inotify_event) char buffer[4096];
+			ssize_t length;
+			while ((length = read(m_NotifyDescriptor, buffer, sizeof(buffer))) > 0)
+			{
+				for (char* event = buffer; event < buffer + length; )
+				{
+					const inotify_event* notification = (const inotify_event*)event;
+					event += sizeof(inotify_event) + notification->len;
+
+					if (notification->len == 0)
+						continue;
+
+					auto directory = std::find_if(m_Directories.begin(), m_Directories.end(),
+						[&](const WatchedDirectory& watched) { return watched.Descriptor == notification->wd; });
+					if (directory != m_Directories.end())
+						changes.push_back(AssetPack::NormalizePath(directory->Path + "/" + notification->name));
+				}
+			}
+		}
+#endif
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - m_LastScan >= PollInterval)
+		{
+			m_LastScan = now;
+			for (WatchedDirectory& directory : m_Directories)
+			{
+				if (directory.Descriptor < 0)
+					ScanDirectory(directory, &changes);
+			}
+		}
+
+		// Saving usually produces several events for the same file
+		std::sort(changes.begin(), changes.end());
+		changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+		return changes;
+	}
+
+}
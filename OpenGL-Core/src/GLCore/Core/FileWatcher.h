@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GLCore {
+
+	// Reports files that were written in a set of watched directories (not
+	// recursive). On Linux this is inotify and Poll() is one non-blocking
+	// read; elsewhere Poll() compares modification times, at most every
+	// PollInterval. Meant to be polled once a frame from the main thread.
+	class FileWatcher
+	{
+	public:
+		static constexpr std::chrono::milliseconds PollInterval{ 250 };
+
+		FileWatcher();
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		// False if the directory does not exist; watching one twice is a no-op
+		bool Watch(const std::string& directory);
+		bool IsWatching(const std::string& directory) const;
+
+		// Normalized paths (see AssetPack::NormalizePath) of the files written
+		// since the last call, each listed once
+		std::vector<std::string> Poll();
+
+		// True when backed by OS notifications rather than polling
+		bool IsNative() const;
+	private:
+		struct WatchedDirectory
+		{
+			std::string Path;
+			int Descriptor = -1;
+			std::unordered_map<std::string, std::filesystem::file_time_type> WriteTimes;
+		};
+
+		void ScanDirectory(WatchedDirectory& directory, std::vector<std::string>* changes);
+	private:
+		int m_NotifyDescriptor = -1;
+		std::vector<WatchedDirectory> m_Directories;
+		std::chrono::steady_clock::time_point m_LastScan;
+	};
+
+}
@@ -0,0 +1,191 @@
+#include "glpch.h"
+#include "AsyncTextureLoader.h"
+
+#include "GLStateCache.h"
+
+#include "GLCore/Util/Timer.h"
+
+#include <stb_image.h>
+
+namespace GLCore {
+
+	AsyncTextureLoader::AsyncTextureLoader(const AsyncTextureLoaderSpecification& spec)
+		: m_Specification(spec)
+	{
+		m_Staging = std::make_unique<StreamBuffer>(m_Specification.StagingSize);
+
+		// Grey checker, obviously not final art
+		const uint32_t placeholderData[] = { 0xff808080, 0xffc0c0c0, 0xffc0c0c0, 0xff808080 };
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_PlaceholderTexture);
+		glTextureParameteri(m_PlaceholderTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTextureParameteri(m_PlaceholderTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureStorage2D(m_PlaceholderTexture, 1, GL_RGBA8, 2, 2);
+		glTextureSubImage2D(m_PlaceholderTexture, 0, 0, 0, 2, 2, GL_RGBA, GL_UNSIGNED_BYTE, placeholderData);
+
+		// The flip flag is process wide in this stb_image version; Image::FromFile
+		// only ever sets it to 1, so set it before any decode thread runs
+		stbi_set_flip_vertically_on_load(1);
+
+		uint32_t threadCount = m_Specification.ThreadCount;
+		if (threadCount == 0)
+			threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+		m_Workers.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+			m_Workers.emplace_back(&AsyncTextureLoader::WorkerLoop, this);
+	}
+
+	AsyncTextureLoader::~AsyncTextureLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stop = true;
+		}
+		m_WakeCondition.notify_all();
+		for (std::thread& worker : m_Workers)
+			worker.join();
+
+		for (const Entry& entry : m_Entries)
+			glDeleteTextures(1, &entry.Texture);
+		for (const Upload& upload : m_Uploads)
+			glDeleteTextures(1, &upload.Texture);
+		glDeleteTextures(1, &m_PlaceholderTexture);
+
+		// The names above may be reused
+		GLStateCache::Invalidate();
+	}
+
+	uint32_t AsyncTextureLoader::Load(const std::string& path)
+	{
+		uint32_t handle = (uint32_t)m_Entries.size();
+		m_Entries.push_back({ path });
+		m_PendingCount++;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_DecodeQueue.push_back({ handle, path });
+		}
+		m_WakeCondition.notify_one();
+		return handle;
+	}
+
+	void AsyncTextureLoader::WorkerLoop()
+	{
+		while (true)
+		{
+			DecodeJob job;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WakeCondition.wait(lock, [this]() { return m_Stop || !m_DecodeQueue.empty(); });
+				if (m_Stop)
+					return;
+
+				job = std::move(m_DecodeQueue.front());
+				m_DecodeQueue.pop_front();
+			}
+
+			Utils::Timer timer;
+			Utils::Image image = Utils::Image::FromFile(job.Path, 4);
+			float decodeMs = timer.ElapsedMillis();
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Decoded.push_back({ job.Handle, std::move(image), decodeMs });
+		}
+	}
+
+	void AsyncTextureLoader::Update()
+	{
+		Utils::Timer timer;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (DecodeResult& result : m_Decoded)
+			{
+				m_Stats.DecodeMs += result.DecodeMs;
+
+				if (!result.Image.IsValid())
+				{
+					m_Entries[result.Handle].TextureState = State::Failed;
+					m_Stats.TexturesFailed++;
+					m_PendingCount--;
+					continue;
+				}
+
+				Upload upload;
+				upload.Handle = result.Handle;
+				upload.Image = std::move(result.Image);
+				m_Uploads.push_back(std::move(upload));
+			}
+			m_Decoded.clear();
+		}
+
+		if (m_Uploads.empty())
+		{
+			m_Stats.LastUpdateMs = timer.ElapsedMillis();
+			return;
+		}
+
+		GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Staging->GetRendererID());
+
+		// At least one strip per frame, so even a tiny budget makes progress
+		do
+		{
+			Upload& upload = m_Uploads.front();
+			const uint32_t width = upload.Image.Width, height = upload.Image.Height;
+			const uint32_t rowSize = width * 4;
+			GLCORE_ASSERT(rowSize <= m_Specification.StagingSize, "Texture row does not fit into the staging buffer!");
+
+			if (upload.Texture == 0)
+			{
+				glCreateTextures(GL_TEXTURE_2D, 1, &upload.Texture);
+				glTextureParameteri(upload.Texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(upload.Texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTextureParameteri(upload.Texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(upload.Texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				glTextureStorage2D(upload.Texture, 1, GL_RGBA8, width, height);
+			}
+
+			// The copy from the unpack buffer into the texture happens on the GPU timeline
+			uint32_t rows = std::min(height - upload.NextRow, m_Specification.StagingSize / rowSize);
+			uint32_t offset = m_Staging->Upload(&upload.Image.Pixels[(size_t)upload.NextRow * rowSize], rows * rowSize, 4);
+			glTextureSubImage2D(upload.Texture, 0, 0, upload.NextRow, width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)offset);
+			m_Staging->Fence();
+
+			upload.NextRow += rows;
+			m_Stats.UploadedBytes += rows * rowSize;
+
+			if (upload.NextRow == height)
+			{
+				Entry& entry = m_Entries[upload.Handle];
+				entry.Texture = upload.Texture;
+				entry.TextureState = State::Ready;
+				m_Stats.TexturesLoaded++;
+				m_PendingCount--;
+				m_Uploads.pop_front();
+			}
+		} while (!m_Uploads.empty() && timer.ElapsedMillis() < m_Specification.FrameBudgetMs);
+
+		// Uploads from client memory elsewhere must not source from the ring
+		GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		m_Stats.LastUpdateMs = timer.ElapsedMillis();
+		m_Stats.UploadMs += m_Stats.LastUpdateMs;
+	}
+
+	GLuint AsyncTextureLoader::GetTexture(uint32_t handle) const
+	{
+		GLuint texture = m_Entries[handle].Texture;
+		return texture ? texture : m_PlaceholderTexture;
+	}
+
+	bool AsyncTextureLoader::IsReady(uint32_t handle) const
+	{
+		return m_Entries[handle].TextureState == State::Ready;
+	}
+
+	bool AsyncTextureLoader::HasFailed(uint32_t handle) const
+	{
+		return m_Entries[handle].TextureState == State::Failed;
+	}
+
+}
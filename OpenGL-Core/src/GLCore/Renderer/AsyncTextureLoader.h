@@ -0,0 +1,120 @@
+#pragma once
+
+#include "StreamBuffer.h"
+
+#include "GLCore/Util/Texture.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace GLCore {
+
+	struct AsyncTextureLoaderSpecification
+	{
+		uint32_t ThreadCount = 0;          // decode threads, 0 = one per core besides the GL thread
+		uint32_t StagingSize = 8 << 20;    // largest single upload through the pixel unpack ring
+		float FrameBudgetMs = 2.0f;        // GL thread time Update() may spend uploading
+	};
+
+	// Loads textures without stalling the GL thread. Images are decoded with
+	// stb_image on a pool of worker threads; Update() then copies them into a
+	// ring of pixel unpack buffers and issues glTextureSubImage2D in row strips
+	// until the frame budget is spent, so one huge image is spread over several
+	// frames instead of causing a hitch. Until a texture is complete GetTexture
+	// returns a placeholder, so callers can draw with the handle right away.
+	class AsyncTextureLoader
+	{
+	public:
+		AsyncTextureLoader(const AsyncTextureLoaderSpecification& spec = AsyncTextureLoaderSpecification());
+		~AsyncTextureLoader();
+
+		AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+		AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+		// Queues path for decoding and returns its handle
+		uint32_t Load(const std::string& path);
+
+		// Call once per frame on the GL thread
+		void Update();
+
+		// The loaded texture, or the placeholder while it is in flight (or failed to load)
+		GLuint GetTexture(uint32_t handle) const;
+		bool IsReady(uint32_t handle) const;
+		bool HasFailed(uint32_t handle) const;
+
+		// Textures queued, decoding or uploading
+		uint32_t GetPendingCount() const { return m_PendingCount; }
+		bool IsIdle() const { return m_PendingCount == 0; }
+
+		GLuint GetPlaceholderTexture() const { return m_PlaceholderTexture; }
+		uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size(); }
+
+		struct Statistics
+		{
+			uint32_t TexturesLoaded = 0;
+			uint32_t TexturesFailed = 0;
+			uint64_t UploadedBytes = 0;
+			float DecodeMs = 0.0f;      // summed over all decode threads
+			float UploadMs = 0.0f;      // GL thread time spent in Update()
+			float LastUpdateMs = 0.0f;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		void WorkerLoop();
+	private:
+		enum class State
+		{
+			Pending = 0, Ready, Failed
+		};
+
+		struct Entry
+		{
+			std::string Path;
+			GLuint Texture = 0;
+			State TextureState = State::Pending;
+		};
+
+		struct DecodeJob
+		{
+			uint32_t Handle;
+			std::string Path;
+		};
+
+		struct DecodeResult
+		{
+			uint32_t Handle;
+			Utils::Image Image;
+			float DecodeMs;
+		};
+
+		// GL thread only: a decoded image being copied in, NextRow onwards is still missing
+		struct Upload
+		{
+			uint32_t Handle;
+			Utils::Image Image;
+			GLuint Texture = 0;
+			uint32_t NextRow = 0;
+		};
+
+		AsyncTextureLoaderSpecification m_Specification;
+
+		std::vector<Entry> m_Entries;
+		std::deque<Upload> m_Uploads;
+		std::unique_ptr<StreamBuffer> m_Staging;
+		GLuint m_PlaceholderTexture = 0;
+		uint32_t m_PendingCount = 0;
+		Statistics m_Stats;
+
+		// Shared with the decode threads
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeCondition;
+		std::deque<DecodeJob> m_DecodeQueue;
+		std::vector<DecodeResult> m_Decoded;
+		bool m_Stop = false;
+	};
+
+}
@@ -0,0 +1,147 @@
+#include "glpch.h"
+#include "Buffer.h"
+
+namespace GLCore {
+
+	uint32_t BufferElement::GetComponentCount() const
+	{
+		switch (Type)
+		{
+		case VertexElementType::Float:       return 1;
+		case VertexElementType::Float2:      return 2;
+		case VertexElementType::Float3:      return 3;
+		case VertexElementType::Float4:      return 4;
+		case VertexElementType::Mat4:        return 4; // per location
+		case VertexElementType::Int:         return 1;
+		case VertexElementType::Int2:        return 2;
+		case VertexElementType::Int3:        return 3;
+		case VertexElementType::Int4:        return 4;
+		case VertexElementType::UInt:        return 1;
+		case VertexElementType::UInt2:       return 2;
+		case VertexElementType::UInt3:       return 3;
+		case VertexElementType::UInt4:       return 4;
+		case VertexElementType::UIntToFloat: return 1;
+		case VertexElementType::UNorm8x4:    return 4;
+		case VertexElementType::UNorm16x2:   return 2;
+		case VertexElementType::Half2:       return 2;
+		case VertexElementType::None:        break;
+		}
+
+		GLCORE_ASSERT(false, "Unknown vertex element type!");
+		return 0;
+	}
+
+	uint32_t BufferElement::GetLocationCount() const
+	{
+		return Type == VertexElementType::Mat4 ? 4 : 1;
+	}
+
+	GLenum BufferElement::GetGLBaseType() const
+	{
+		switch (Type)
+		{
+		case VertexElementType::Float:
+		case VertexElementType::Float2:
+		case VertexElementType::Float3:
+		case VertexElementType::Float4:
+		case VertexElementType::Mat4:        return GL_FLOAT;
+		case VertexElementType::Int:
+		case VertexElementType::Int2:
+		case VertexElementType::Int3:
+		case VertexElementType::Int4:        return GL_INT;
+		case VertexElementType::UInt:
+		case VertexElementType::UInt2:
+		case VertexElementType::UInt3:
+		case VertexElementType::UInt4:
+		case VertexElementType::UIntToFloat: return GL_UNSIGNED_INT;
+		case VertexElementType::UNorm8x4:    return GL_UNSIGNED_BYTE;
+		case VertexElementType::UNorm16x2:   return GL_UNSIGNED_SHORT;
+		case VertexElementType::Half2:       return GL_HALF_FLOAT;
+		case VertexElementType::None:        break;
+		}
+
+		GLCORE_ASSERT(false, "Unknown vertex element type!");
+		return 0;
+	}
+
+	bool BufferElement::IsNormalized() const
+	{
+		return Type == VertexElementType::UNorm8x4 || Type == VertexElementType::UNorm16x2;
+	}
+
+	bool BufferElement::IsInteger() const
+	{
+		switch (Type)
+		{
+		case VertexElementType::Int:
+		case VertexElementType::Int2:
+		case VertexElementType::Int3:
+		case VertexElementType::Int4:
+		case VertexElementType::UInt:
+		case VertexElementType::UInt2:
+		case VertexElementType::UInt3:
+		case VertexElementType::UInt4:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	BufferLayout::BufferLayout(std::initializer_list<BufferElement> elements)
+		: m_Elements(elements)
+	{
+		uint32_t offset = 0;
+		for (BufferElement& element : m_Elements)
+		{
+			element.Offset = offset;
+			offset += element.Size;
+		}
+		m_Stride = offset;
+	}
+
+	BufferLayout::BufferLayout(std::initializer_list<BufferElement> elements, uint32_t stride)
+		: m_Elements(elements), m_Stride(stride)
+	{
+		for (const BufferElement& element : m_Elements)
+			GLCORE_ASSERT(element.Offset + element.Size <= m_Stride, "Vertex element lies outside the vertex!");
+	}
+
+	VertexBuffer::VertexBuffer(uint32_t size)
+		: m_Size(size), m_Dynamic(true)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+
+	VertexBuffer::VertexBuffer(const void* data, uint32_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, data, 0);
+	}
+
+	VertexBuffer::~VertexBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void VertexBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		GLCORE_ASSERT(m_Dynamic, "Vertex buffer was created with immutable contents!");
+		GLCORE_ASSERT(offset + size <= m_Size, "Vertex buffer upload out of range!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	IndexBuffer::IndexBuffer(const uint32_t* indices, uint32_t count)
+		: m_Count(count)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, count * sizeof(uint32_t), indices, 0);
+	}
+
+	IndexBuffer::~IndexBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace GLCore {
+
+	// How one vertex member is fed to the shader. The integer types reach the
+	// shader as int/uint (glVertexArrayAttribIFormat); everything else arrives
+	// as float, converted by the fixed function fetch.
+	enum class VertexElementType
+	{
+		None = 0,
+		Float, Float2, Float3, Float4, Mat4,
+		Int, Int2, Int3, Int4,
+		UInt, UInt2, UInt3, UInt4,
+		UIntToFloat, // uint32 in memory, float in the shader
+		UNorm8x4,    // RGBA8 color
+		UNorm16x2,   // quantized texture coordinates
+		Half2        // packed half floats
+	};
+
+	constexpr uint32_t GetVertexElementTypeSize(VertexElementType type)
+	{
+		switch (type)
+		{
+		case VertexElementType::Float:       return 4;
+		case VertexElementType::Float2:      return 4 * 2;
+		case VertexElementType::Float3:      return 4 * 3;
+		case VertexElementType::Float4:      return 4 * 4;
+		case VertexElementType::Mat4:        return 4 * 4 * 4;
+		case VertexElementType::Int:         return 4;
+		case VertexElementType::Int2:        return 4 * 2;
+		case VertexElementType::Int3:        return 4 * 3;
+		case VertexElementType::Int4:        return 4 * 4;
+		case VertexElementType::UInt:        return 4;
+		case VertexElementType::UInt2:       return 4 * 2;
+		case VertexElementType::UInt3:       return 4 * 3;
+		case VertexElementType::UInt4:       return 4 * 4;
+		case VertexElementType::UIntToFloat: return 4;
+		case VertexElementType::UNorm8x4:    return 4;
+		case VertexElementType::UNorm16x2:   return 2 * 2;
+		case VertexElementType::Half2:       return 2 * 2;
+		case VertexElementType::None:        return 0;
+		}
+		return 0;
+	}
+
+	// Maps a C++ member type to the element type it is uploaded as; packed
+	// members (uint16_t[2], RGBA8 in a uint32_t, ...) have to name their type
+	// explicitly with GLCORE_VERTEX_ELEMENT_AS
+	template<typename T> struct VertexElementTypeOf;
+	template<> struct VertexElementTypeOf<float>      { static constexpr VertexElementType Value = VertexElementType::Float; };
+	template<> struct VertexElementTypeOf<glm::vec2>  { static constexpr VertexElementType Value = VertexElementType::Float2; };
+	template<> struct VertexElementTypeOf<glm::vec3>  { static constexpr VertexElementType Value = VertexElementType::Float3; };
+	template<> struct VertexElementTypeOf<glm::vec4>  { static constexpr VertexElementType Value = VertexElementType::Float4; };
+	template<> struct VertexElementTypeOf<glm::mat4>  { static constexpr VertexElementType Value = VertexElementType::Mat4; };
+	template<> struct VertexElementTypeOf<int32_t>    { static constexpr VertexElementType Value = VertexElementType::Int; };
+	template<> struct VertexElementTypeOf<glm::ivec2> { static constexpr VertexElementType Value = VertexElementType::Int2; };
+	template<> struct VertexElementTypeOf<glm::ivec3> { static constexpr VertexElementType Value = VertexElementType::Int3; };
+	template<> struct VertexElementTypeOf<glm::ivec4> { static constexpr VertexElementType Value = VertexElementType::Int4; };
+	template<> struct VertexElementTypeOf<uint32_t>   { static constexpr VertexElementType Value = VertexElementType::UInt; };
+	template<> struct VertexElementTypeOf<glm::uvec2> { static constexpr VertexElementType Value = VertexElementType::UInt2; };
+	template<> struct VertexElementTypeOf<glm::uvec3> { static constexpr VertexElementType Value = VertexElementType::UInt3; };
+	template<> struct VertexElementTypeOf<glm::uvec4> { static constexpr VertexElementType Value = VertexElementType::UInt4; };
+
+	struct BufferElement
+	{
+		const char* Name = "";
+		VertexElementType Type = VertexElementType::None;
+		uint32_t Size = 0;
+		uint32_t Offset = 0;
+
+		BufferElement() = default;
+
+		// Offset is filled in by BufferLayout for tightly packed layouts
+		BufferElement(VertexElementType type, const char* name, uint32_t offset = 0)
+			: Name(name), Type(type), Size(GetVertexElementTypeSize(type)), Offset(offset)
+		{
+		}
+
+		// Checks at compile time that type covers the whole member
+		template<VertexElementType ElementType, size_t MemberSize>
+		static BufferElement Create(const char* name, size_t offset)
+		{
+			static_assert(GetVertexElementTypeSize(ElementType) == MemberSize, "Vertex element type does not match the member size!");
+			return BufferElement(ElementType, name, (uint32_t)offset);
+		}
+
+		uint32_t GetComponentCount() const;
+		// Number of consecutive attribute locations the element occupies (4 for Mat4)
+		uint32_t GetLocationCount() const;
+		GLenum GetGLBaseType() const;
+		bool IsNormalized() const;
+		bool IsInteger() const;
+	};
+
+	// Element for Vertex::Member, with type and offset taken from the struct
+	#define GLCORE_VERTEX_ELEMENT(Vertex, Member) \
+		::GLCore::BufferElement::Create<::GLCore::VertexElementTypeOf<decltype(Vertex::Member)>::Value, sizeof(Vertex::Member)>(#Member, offsetof(Vertex, Member))
+	// Element for a packed Vertex::Member uploaded as type
+	#define GLCORE_VERTEX_ELEMENT_AS(Vertex, Member, type) \
+		::GLCore::BufferElement::Create<type, sizeof(Vertex::Member)>(#Member, offsetof(Vertex, Member))
+
+	class BufferLayout
+	{
+	public:
+		BufferLayout() = default;
+
+		// Tightly packed elements; offsets and stride follow from the element sizes
+		BufferLayout(std::initializer_list<BufferElement> elements);
+
+		// Elements of a vertex struct (see GLCORE_VERTEX_ELEMENT), stride is sizeof(Vertex)
+		template<typename Vertex>
+		static BufferLayout Create(std::initializer_list<BufferElement> elements)
+		{
+			return BufferLayout(elements, sizeof(Vertex));
+		}
+
+		uint32_t GetStride() const { return m_Stride; }
+		const std::vector<BufferElement>& GetElements() const { return m_Elements; }
+
+		std::vector<BufferElement>::const_iterator begin() const { return m_Elements.begin(); }
+		std::vector<BufferElement>::const_iterator end() const { return m_Elements.end(); }
+	private:
+		BufferLayout(std::initializer_list<BufferElement> elements, uint32_t stride);
+	private:
+		std::vector<BufferElement> m_Elements;
+		uint32_t m_Stride = 0;
+	};
+
+	class VertexBuffer
+	{
+	public:
+		// Dynamic storage, filled through SetData
+		VertexBuffer(uint32_t size);
+		// Immutable storage initialized with data
+		VertexBuffer(const void* data, uint32_t size);
+		~VertexBuffer();
+
+		VertexBuffer(const VertexBuffer&) = delete;
+		VertexBuffer& operator=(const VertexBuffer&) = delete;
+
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0);
+
+		const BufferLayout& GetLayout() const { return m_Layout; }
+		void SetLayout(const BufferLayout& layout) { m_Layout = layout; }
+
+		GLuint GetRendererID() const { return m_RendererID; }
+		uint32_t GetSize() const { return m_Size; }
+	private:
+		GLuint m_RendererID = 0;
+		uint32_t m_Size = 0;
+		bool m_Dynamic = false;
+		BufferLayout m_Layout;
+	};
+
+	// 32-bit indices in immutable storage
+	class IndexBuffer
+	{
+	public:
+		IndexBuffer(const uint32_t* indices, uint32_t count);
+		~IndexBuffer();
+
+		IndexBuffer(const IndexBuffer&) = delete;
+		IndexBuffer& operator=(const IndexBuffer&) = delete;
+
+		GLuint GetRendererID() const { return m_RendererID; }
+		uint32_t GetCount() const { return m_Count; }
+	private:
+		GLuint m_RendererID = 0;
+		uint32_t m_Count = 0;
+	};
+
+}
@@ -0,0 +1,315 @@
+#include "glpch.h"
+#include "GLStateCache.h"
+
+namespace GLCore {
+
+	// Shadow value that never matches a real one
+	static const GLuint s_Unknown = 0xffffffff;
+
+	static const uint32_t s_MaxIndexedBindings = 32;
+
+	struct IndexedBinding
+	{
+		GLuint Buffer = s_Unknown;
+		GLintptr Offset = 0;
+		GLsizeiptr Size = 0;
+	};
+
+	struct GLStateCacheData
+	{
+		bool Enabled = true;
+
+		GLuint Program = s_Unknown;
+		GLuint VertexArray = s_Unknown;
+
+		// Generic bind points, see GetBufferSlot
+		GLuint Buffers[8];
+		IndexedBinding UniformBuffers[s_MaxIndexedBindings];
+		IndexedBinding StorageBuffers[s_MaxIndexedBindings];
+
+		std::vector<GLuint> TextureUnits;
+
+		// Capabilities, see GetCapabilitySlot: 0 = disabled, 1 = enabled, s_Unknown = unknown
+		GLuint Capabilities[6];
+		GLenum BlendSource = s_Unknown, BlendDestination = s_Unknown;
+		GLenum DepthFunction = s_Unknown;
+		GLuint DepthWrite = s_Unknown;
+
+		GLStateCache::Statistics Stats;
+	};
+
+	static GLStateCacheData s_StateData;
+
+	static int GetBufferSlot(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:          return 0;
+		case GL_ELEMENT_ARRAY_BUFFER:  return 1;
+		case GL_DRAW_INDIRECT_BUFFER:  return 2;
+		case GL_UNIFORM_BUFFER:        return 3;
+		case GL_SHADER_STORAGE_BUFFER: return 4;
+		case GL_PIXEL_UNPACK_BUFFER:   return 5;
+		case GL_PIXEL_PACK_BUFFER:     return 6;
+		case GL_COPY_WRITE_BUFFER:     return 7;
+		}
+		return -1;
+	}
+
+	static int GetCapabilitySlot(GLenum capability)
+	{
+		switch (capability)
+		{
+		case GL_BLEND:              return 0;
+		case GL_DEPTH_TEST:         return 1;
+		case GL_CULL_FACE:          return 2;
+		case GL_SCISSOR_TEST:       return 3;
+		case GL_STENCIL_TEST:       return 4;
+		case GL_RASTERIZER_DISCARD: return 5;
+		}
+		return -1;
+	}
+
+	// Updates the shadow and returns true if the call has to be issued
+	template<typename T>
+	static bool Track(GLStateCall call, T& shadow, T value)
+	{
+		if (s_StateData.Enabled && shadow == value)
+		{
+			s_StateData.Stats.Elided[(int)call]++;
+			return false;
+		}
+
+		shadow = value;
+		s_StateData.Stats.Issued[(int)call]++;
+		return true;
+	}
+
+	static void Issue(GLStateCall call)
+	{
+		s_StateData.Stats.Issued[(int)call]++;
+	}
+
+	void GLStateCache::Init()
+	{
+		GLint maxTextureUnits = 0;
+		glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+		s_StateData.TextureUnits.resize(maxTextureUnits);
+
+		Invalidate();
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		s_StateData.Program = s_Unknown;
+		s_StateData.VertexArray = s_Unknown;
+		for (GLuint& buffer : s_StateData.Buffers)
+			buffer = s_Unknown;
+		for (uint32_t i = 0; i < s_MaxIndexedBindings; i++)
+		{
+			s_StateData.UniformBuffers[i] = IndexedBinding();
+			s_StateData.StorageBuffers[i] = IndexedBinding();
+		}
+		std::fill(s_StateData.TextureUnits.begin(), s_StateData.TextureUnits.end(), s_Unknown);
+		for (GLuint& capability : s_StateData.Capabilities)
+			capability = s_Unknown;
+		s_StateData.BlendSource = s_Unknown;
+		s_StateData.BlendDestination = s_Unknown;
+		s_StateData.DepthFunction = s_Unknown;
+		s_StateData.DepthWrite = s_Unknown;
+	}
+
+	void GLStateCache::SetEnabled(bool enabled)
+	{
+		s_StateData.Enabled = enabled;
+	}
+
+	bool GLStateCache::IsEnabled()
+	{
+		return s_StateData.Enabled;
+	}
+
+	void GLStateCache::UseProgram(GLuint program)
+	{
+		if (Track(GLStateCall::Program, s_StateData.Program, program))
+			glUseProgram(program);
+	}
+
+	void GLStateCache::BindVertexArray(GLuint vertexArray)
+	{
+		if (Track(GLStateCall::VertexArray, s_StateData.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+
+			// The element buffer binding is part of the vertex array
+			s_StateData.Buffers[GetBufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = s_Unknown;
+		}
+	}
+
+	void GLStateCache::BindBuffer(GLenum target, GLuint buffer)
+	{
+		int slot = GetBufferSlot(target);
+		if (slot < 0)
+		{
+			Issue(GLStateCall::Buffer);
+			glBindBuffer(target, buffer);
+			return;
+		}
+
+		if (Track(GLStateCall::Buffer, s_StateData.Buffers[slot], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void GLStateCache::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		IndexedBinding* bindings = nullptr;
+		if (target == GL_UNIFORM_BUFFER)
+			bindings = s_StateData.UniformBuffers;
+		else if (target == GL_SHADER_STORAGE_BUFFER)
+			bindings = s_StateData.StorageBuffers;
+
+		if (!bindings || index >= s_MaxIndexedBindings)
+		{
+			Issue(GLStateCall::Buffer);
+			glBindBufferRange(target, index, buffer, offset, size);
+			return;
+		}
+
+		IndexedBinding& binding = bindings[index];
+		if (s_StateData.Enabled && binding.Buffer == buffer && binding.Offset == offset && binding.Size == size)
+		{
+			s_StateData.Stats.Elided[(int)GLStateCall::Buffer]++;
+			return;
+		}
+
+		binding = { buffer, offset, size };
+		Issue(GLStateCall::Buffer);
+		glBindBufferRange(target, index, buffer, offset, size);
+
+		// Indexed binds also replace the generic bind point
+		s_StateData.Buffers[GetBufferSlot(target)] = buffer;
+	}
+
+	void GLStateCache::BindTextureUnit(GLuint unit, GLuint texture)
+	{
+		if (unit >= s_StateData.TextureUnits.size())
+		{
+			Issue(GLStateCall::Texture);
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (Track(GLStateCall::Texture, s_StateData.TextureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void GLStateCache::BindTextures(GLuint first, GLsizei count, const GLuint* textures)
+	{
+		bool changed = !s_StateData.Enabled || first + count > s_StateData.TextureUnits.size();
+		for (GLsizei i = 0; i < count && !changed; i++)
+			changed = s_StateData.TextureUnits[first + i] != (textures ? textures[i] : 0);
+
+		if (!changed)
+		{
+			s_StateData.Stats.Elided[(int)GLStateCall::Texture]++;
+			return;
+		}
+
+		for (GLsizei i = 0; i < count && first + i < s_StateData.TextureUnits.size(); i++)
+			s_StateData.TextureUnits[first + i] = textures ? textures[i] : 0;
+
+		Issue(GLStateCall::Texture);
+		glBindTextures(first, count, textures);
+	}
+
+	void GLStateCache::Enable(GLenum capability)
+	{
+		int slot = GetCapabilitySlot(capability);
+		if (slot < 0)
+			Issue(GLStateCall::Capability);
+		else if (!Track(GLStateCall::Capability, s_StateData.Capabilities[slot], (GLuint)1))
+			return;
+
+		glEnable(capability);
+	}
+
+	void GLStateCache::Disable(GLenum capability)
+	{
+		int slot = GetCapabilitySlot(capability);
+		if (slot < 0)
+			Issue(GLStateCall::Capability);
+		else if (!Track(GLStateCall::Capability, s_StateData.Capabilities[slot], (GLuint)0))
+			return;
+
+		glDisable(capability);
+	}
+
+	void GLStateCache::BlendFunc(GLenum source, GLenum destination)
+	{
+		if (s_StateData.Enabled && s_StateData.BlendSource == source && s_StateData.BlendDestination == destination)
+		{
+			s_StateData.Stats.Elided[(int)GLStateCall::Blend]++;
+			return;
+		}
+
+		s_StateData.BlendSource = source;
+		s_StateData.BlendDestination = destination;
+		Issue(GLStateCall::Blend);
+		glBlendFunc(source, destination);
+	}
+
+	void GLStateCache::DepthFunc(GLenum function)
+	{
+		if (Track(GLStateCall::Depth, s_StateData.DepthFunction, function))
+			glDepthFunc(function);
+	}
+
+	void GLStateCache::DepthMask(GLboolean mask)
+	{
+		if (Track(GLStateCall::Depth, s_StateData.DepthWrite, (GLuint)mask))
+			glDepthMask(mask);
+	}
+
+	uint32_t GLStateCache::Statistics::GetTotalIssued() const
+	{
+		uint32_t total = 0;
+		for (uint32_t count : Issued)
+			total += count;
+		return total;
+	}
+
+	uint32_t GLStateCache::Statistics::GetTotalElided() const
+	{
+		uint32_t total = 0;
+		for (uint32_t count : Elided)
+			total += count;
+		return total;
+	}
+
+	const GLStateCache::Statistics& GLStateCache::GetStats()
+	{
+		return s_StateData.Stats;
+	}
+
+	void GLStateCache::ResetStats()
+	{
+		s_StateData.Stats = Statistics();
+	}
+
+	const char* GLStateCache::GetCallName(GLStateCall call)
+	{
+		switch (call)
+		{
+		case GLStateCall::Program:     return "Program";
+		case GLStateCall::VertexArray: return "Vertex Array";
+		case GLStateCall::Buffer:      return "Buffer";
+		case GLStateCall::Texture:     return "Texture";
+		case GLStateCall::Capability:  return "Capability";
+		case GLStateCall::Blend:       return "Blend";
+		case GLStateCall::Depth:       return "Depth";
+		case GLStateCall::Count:       break;
+		}
+		return "Unknown";
+	}
+
+}
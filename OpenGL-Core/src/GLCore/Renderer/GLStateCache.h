@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace GLCore {
+
+	enum class GLStateCall
+	{
+		Program = 0, VertexArray, Buffer, Texture, Capability, Blend, Depth,
+		Count
+	};
+
+	// Shadows the bits of GL state the renderer touches every frame and drops
+	// calls that would not change anything. Only works if every bind goes
+	// through here: call Invalidate() after code that changes state behind its
+	// back (ImGui, third party code) or after deleting an object that might
+	// still be bound, since GL may hand out the same name again.
+	class GLStateCache
+	{
+	public:
+		static void Init();
+		static void Invalidate();
+
+		// Disabled, every call is forwarded (and counted as issued); useful to measure what the cache saves
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vertexArray);
+		static void BindBuffer(GLenum target, GLuint buffer);
+		static void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+		static void BindTextureUnit(GLuint unit, GLuint texture);
+		// One multi-bind when any unit in [first, first + count) differs, textures = nullptr unbinds
+		static void BindTextures(GLuint first, GLsizei count, const GLuint* textures);
+
+		static void Enable(GLenum capability);
+		static void Disable(GLenum capability);
+		static void BlendFunc(GLenum source, GLenum destination);
+		static void DepthFunc(GLenum function);
+		static void DepthMask(GLboolean mask);
+
+		struct Statistics
+		{
+			uint32_t Issued[(int)GLStateCall::Count] = {};
+			uint32_t Elided[(int)GLStateCall::Count] = {};
+
+			uint32_t GetTotalIssued() const;
+			uint32_t GetTotalElided() const;
+		};
+		static const Statistics& GetStats();
+		static void ResetStats();
+
+		static const char* GetCallName(GLStateCall call);
+	};
+
+}
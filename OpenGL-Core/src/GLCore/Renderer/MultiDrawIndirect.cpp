@@ -0,0 +1,70 @@
+#include "glpch.h"
+#include "MultiDrawIndirect.h"
+
+#include "GLStateCache.h"
+#include "VertexArray.h"
+
+namespace GLCore {
+
+	static bool s_ForceFallback = false;
+
+	bool MultiDrawIndirect::IsSupported()
+	{
+		return GLAD_GL_VERSION_4_3;
+	}
+
+	void MultiDrawIndirect::SetForceFallback(bool force)
+	{
+		s_ForceFallback = force;
+	}
+
+	bool MultiDrawIndirect::IsFallbackForced()
+	{
+		return s_ForceFallback;
+	}
+
+	uint32_t MultiDrawIndirect::DrawElements(GLenum mode, GLuint indirectBuffer, uint32_t offset, const DrawElementsIndirectCommand* commands, uint32_t count)
+	{
+		if (count == 0)
+			return 0;
+
+		if (IsSupported() && !s_ForceFallback)
+		{
+			GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+			glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, (const void*)(uintptr_t)offset, count, sizeof(DrawElementsIndirectCommand));
+			return 1;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const DrawElementsIndirectCommand& command = commands[i];
+			glDrawElementsInstancedBaseVertexBaseInstance(mode, command.Count, GL_UNSIGNED_INT,
+				(const void*)(uintptr_t)(command.FirstIndex * sizeof(uint32_t)), command.InstanceCount, command.BaseVertex, command.BaseInstance);
+		}
+		return count;
+	}
+
+	GLuint MultiDrawIndirect::CreateDrawIndexBuffer(uint32_t maxDraws)
+	{
+		std::vector<uint32_t> indices(maxDraws);
+		for (uint32_t i = 0; i < maxDraws; i++)
+			indices[i] = i;
+
+		GLuint buffer;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, indices.size() * sizeof(uint32_t), indices.data(), 0);
+		return buffer;
+	}
+
+	void MultiDrawIndirect::AttachDrawIndexAttribute(GLuint vertexArray, GLuint drawIndexBuffer, GLuint attribute, GLuint binding)
+	{
+		static const BufferLayout s_DrawIndexLayout = {
+			{ VertexElementType::UInt, "a_DrawIndex" }
+		};
+
+		VertexArray::ApplyLayout(vertexArray, s_DrawIndexLayout, binding, attribute);
+		glVertexArrayVertexBuffer(vertexArray, binding, drawIndexBuffer, 0, sizeof(uint32_t));
+		glVertexArrayBindingDivisor(vertexArray, binding, 1);
+	}
+
+}
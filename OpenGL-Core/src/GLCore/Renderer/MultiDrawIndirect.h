@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace GLCore {
+
+	// Layout expected by glMultiDrawElementsIndirect
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	// Thin wrapper around indirect multi-draws. Per-draw data is addressed
+	// through the base instance: a draw index buffer (0, 1, 2, ...) attached as
+	// an instanced attribute reads back BaseInstance in the vertex shader, which
+	// works for both the multi-draw and the fallback loop (unlike gl_DrawID).
+	class MultiDrawIndirect
+	{
+	public:
+		// glMultiDrawElementsIndirect is core since GL 4.3 (ARB_multi_draw_indirect)
+		static bool IsSupported();
+
+		// Forces the per-draw loop even where multi-draw is supported, for A/B comparisons
+		static void SetForceFallback(bool force);
+		static bool IsFallbackForced();
+
+		// Draws commands[0..count) with the index buffer of the bound vertex array.
+		// indirectBuffer/offset must hold the same commands; the fallback reads the CPU copy.
+		// Returns the number of draw calls issued.
+		static uint32_t DrawElements(GLenum mode, GLuint indirectBuffer, uint32_t offset, const DrawElementsIndirectCommand* commands, uint32_t count);
+
+		// Immutable buffer holding 0 .. maxDraws - 1
+		static GLuint CreateDrawIndexBuffer(uint32_t maxDraws);
+		// Sources attribute (as a uint) from drawIndexBuffer, advancing once per instance
+		static void AttachDrawIndexAttribute(GLuint vertexArray, GLuint drawIndexBuffer, GLuint attribute, GLuint binding);
+	};
+
+}
@@ -0,0 +1,185 @@
+#include "glpch.h"
+#include "ParallelQuadBuilder.h"
+
+#include <new>
+
+namespace GLCore {
+
+	static const size_t s_CacheLineSize = 64;
+
+	QuadWriter::QuadWriter(ParallelQuadBuilder& builder, std::vector<QuadChunk>& chunks)
+		: m_Builder(builder), m_Chunks(chunks)
+	{
+	}
+
+	QuadVertex* QuadWriter::Reserve(uint32_t count, uint32_t& reserved)
+	{
+		const uint32_t chunkQuads = m_Builder.m_ChunkQuads;
+		if (m_Chunks.empty() || m_Chunks.back().QuadCount == chunkQuads)
+		{
+			uint32_t index = m_Builder.m_NextChunk.fetch_add(1, std::memory_order_relaxed);
+			if (index >= m_Builder.m_ChunkCapacity)
+			{
+				m_Builder.m_DroppedQuadCount.fetch_add(count, std::memory_order_relaxed);
+				reserved = 0;
+				return nullptr;
+			}
+			m_Chunks.push_back({ index, 0 });
+		}
+
+		QuadChunk& chunk = m_Chunks.back();
+		reserved = std::min(count, chunkQuads - chunk.QuadCount);
+		QuadVertex* target = m_Builder.m_Vertices + ((size_t)chunk.Index * chunkQuads + chunk.QuadCount) * 4;
+		chunk.QuadCount += reserved;
+		return target;
+	}
+
+	void QuadWriter::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float texIndex,
+		const glm::vec2& texCoordMin, const glm::vec2& texCoordMax)
+	{
+		uint32_t reserved;
+		QuadVertex* target = Reserve(1, reserved);
+		if (!target)
+			return;
+
+		WriteQuadVertices(QuadVertexFormat::Standard, (uint8_t*)target, position, size, color, texIndex, texCoordMin, texCoordMax);
+	}
+
+	void QuadWriter::DrawQuads(const QuadKernelInput& input)
+	{
+		uint32_t written = 0;
+		while (written < input.Count)
+		{
+			uint32_t reserved;
+			QuadVertex* target = Reserve(input.Count - written, reserved);
+			if (!target)
+				return;
+
+			GenerateQuadVertices(input.Slice(written, reserved), target);
+			written += reserved;
+		}
+	}
+
+	ParallelQuadBuilder::ParallelQuadBuilder(const ParallelQuadBuilderSpecification& spec)
+		: m_Specification(spec)
+	{
+		// A QuadVertex quad is 160 bytes, so an even number of quads fills whole cache lines
+		static_assert((2 * 4 * sizeof(QuadVertex)) % s_CacheLineSize == 0, "Chunk size must be a multiple of the cache line size");
+		m_ChunkQuads = std::max(2u, (spec.ChunkQuads + 1) & ~1u);
+		m_ChunkCapacity = (spec.MaxQuads + m_ChunkQuads - 1) / m_ChunkQuads;
+
+		uint32_t threadCount = spec.ThreadCount ? spec.ThreadCount : std::max(1u, std::thread::hardware_concurrency());
+		for (uint32_t i = 1; i < threadCount; i++)
+			m_Workers.emplace_back(&ParallelQuadBuilder::WorkerLoop, this);
+	}
+
+	ParallelQuadBuilder::~ParallelQuadBuilder()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stop = true;
+		}
+		m_WakeCondition.notify_all();
+		for (std::thread& worker : m_Workers)
+			worker.join();
+
+		if (m_OwnedVertices)
+			::operator delete(m_OwnedVertices, std::align_val_t(s_CacheLineSize));
+	}
+
+	void ParallelQuadBuilder::Build(uint32_t taskCount, const TaskFn& task, QuadVertex* target)
+	{
+		if (!target && !m_OwnedVertices)
+			m_OwnedVertices = (QuadVertex*)::operator new(GetArenaSize(), std::align_val_t(s_CacheLineSize));
+		m_Vertices = target ? target : m_OwnedVertices;
+
+		m_Task = &task;
+		m_TaskCount = taskCount;
+		m_NextTask = 0;
+		m_NextChunk = 0;
+		m_DroppedQuadCount = 0;
+
+		// Chunk lists are per task, so the order below does not depend on which thread ran what
+		m_TaskChunks.resize(taskCount);
+		for (std::vector<QuadChunk>& chunks : m_TaskChunks)
+			chunks.clear();
+
+		if (!m_Workers.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_PendingWorkers = (uint32_t)m_Workers.size();
+				m_Generation++;
+			}
+			m_WakeCondition.notify_all();
+		}
+
+		RunTasks();
+
+		if (!m_Workers.empty())
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_DoneCondition.wait(lock, [this]() { return m_PendingWorkers == 0; });
+		}
+
+		m_Chunks.clear();
+		m_QuadCount = 0;
+		for (const std::vector<QuadChunk>& chunks : m_TaskChunks)
+		{
+			for (const QuadChunk& chunk : chunks)
+			{
+				if (chunk.QuadCount == 0)
+					continue;
+
+				m_Chunks.push_back(chunk);
+				m_QuadCount += chunk.QuadCount;
+			}
+		}
+
+		// Reservation order is the order chunks were handed out, i.e. roughly completion order
+		if (!m_Specification.Deterministic)
+			std::sort(m_Chunks.begin(), m_Chunks.end(), [](const QuadChunk& a, const QuadChunk& b) { return a.Index < b.Index; });
+
+		if (m_DroppedQuadCount > 0)
+			LOG_WARN("ParallelQuadBuilder: arena full, dropped {0} quads", m_DroppedQuadCount.load());
+
+		m_Task = nullptr;
+	}
+
+	void ParallelQuadBuilder::RunTasks()
+	{
+		for (;;)
+		{
+			uint32_t taskIndex = m_NextTask.fetch_add(1, std::memory_order_relaxed);
+			if (taskIndex >= m_TaskCount)
+				break;
+
+			QuadWriter writer(*this, m_TaskChunks[taskIndex]);
+			(*m_Task)(taskIndex, writer);
+		}
+	}
+
+	void ParallelQuadBuilder::WorkerLoop()
+	{
+		uint64_t generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WakeCondition.wait(lock, [&]() { return m_Stop || m_Generation != generation; });
+				if (m_Stop)
+					return;
+				generation = m_Generation;
+			}
+
+			RunTasks();
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (--m_PendingWorkers == 0)
+					m_DoneCondition.notify_one();
+			}
+		}
+	}
+
+}
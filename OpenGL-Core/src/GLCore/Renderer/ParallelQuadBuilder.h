@@ -0,0 +1,119 @@
+#pragma once
+
+#include "QuadVertex.h"
+#include "QuadKernel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace GLCore {
+
+	struct ParallelQuadBuilderSpecification
+	{
+		uint32_t ThreadCount = 0;    // including the calling thread, 0 = hardware concurrency
+		uint32_t ChunkQuads = 128;   // rounded up so chunks stay cache line aligned
+		uint32_t MaxQuads = 1 << 20; // arena capacity, quads past this are dropped
+		bool Deterministic = true;   // chunks ordered by task instead of by reservation
+	};
+
+	// A run of quads written by one task into the builder's arena
+	struct QuadChunk
+	{
+		uint32_t Index = 0;     // position in the arena, in chunks
+		uint32_t QuadCount = 0;
+	};
+
+	class ParallelQuadBuilder;
+
+	// Handed to each task; writes Standard quad vertices into chunks that are
+	// private to the task, reserving a new chunk whenever the current one is full.
+	class QuadWriter
+	{
+	public:
+		void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float texIndex = 0.0f,
+			const glm::vec2& texCoordMin = { 0.0f, 0.0f }, const glm::vec2& texCoordMax = { 1.0f, 1.0f });
+		void DrawQuads(const QuadKernelInput& input);
+	private:
+		QuadWriter(ParallelQuadBuilder& builder, std::vector<QuadChunk>& chunks);
+
+		// Room for up to count quads in the current chunk, may return fewer (0 when the arena is full)
+		QuadVertex* Reserve(uint32_t count, uint32_t& reserved);
+	private:
+		ParallelQuadBuilder& m_Builder;
+		std::vector<QuadChunk>& m_Chunks;
+
+		friend class ParallelQuadBuilder;
+	};
+
+	// Builds quad vertices on a small pool of worker threads. Tasks claim work
+	// through an atomic counter and reserve output chunks through an atomic
+	// cursor, so threads never share a cache line. The calling thread takes part
+	// in the build and gets the chunks back in a well-defined order to draw.
+	class ParallelQuadBuilder
+	{
+	public:
+		using TaskFn = std::function<void(uint32_t taskIndex, QuadWriter& writer)>;
+
+		ParallelQuadBuilder(const ParallelQuadBuilderSpecification& spec = ParallelQuadBuilderSpecification());
+		~ParallelQuadBuilder();
+
+		ParallelQuadBuilder(const ParallelQuadBuilder&) = delete;
+		ParallelQuadBuilder& operator=(const ParallelQuadBuilder&) = delete;
+
+		// Runs task(0 .. taskCount - 1) and blocks until all of them are done. Chunks
+		// are reserved in target when given (GetArenaSize() bytes, cache line aligned,
+		// e.g. mapped GL memory, see Renderer2D::BuildQuads), otherwise in the
+		// builder's own arena, which is allocated by the first build that needs it.
+		void Build(uint32_t taskCount, const TaskFn& task, QuadVertex* target = nullptr);
+
+		// Chunks of the last build, in task order when Deterministic is set
+		const std::vector<QuadChunk>& GetChunks() const { return m_Chunks; }
+		const QuadVertex* GetChunkVertices(const QuadChunk& chunk) const { return m_Vertices + (size_t)chunk.Index * m_ChunkQuads * 4; }
+
+		// Arena of the last build; chunks are handed out from the front, so only the
+		// first GetUsedChunkCount() chunks were written
+		const QuadVertex* GetVertices() const { return m_Vertices; }
+		uint32_t GetUsedChunkCount() const { return std::min(m_NextChunk.load(), m_ChunkCapacity); }
+		uint32_t GetChunkQuads() const { return m_ChunkQuads; }
+		uint32_t GetArenaSize() const { return m_ChunkCapacity * m_ChunkQuads * 4 * (uint32_t)sizeof(QuadVertex); }
+
+		uint32_t GetQuadCount() const { return m_QuadCount; }
+		uint32_t GetDroppedQuadCount() const { return m_DroppedQuadCount.load(); }
+		uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size() + 1; }
+		const ParallelQuadBuilderSpecification& GetSpecification() const { return m_Specification; }
+	private:
+		void WorkerLoop();
+		void RunTasks();
+	private:
+		ParallelQuadBuilderSpecification m_Specification;
+		uint32_t m_ChunkQuads = 0;
+		uint32_t m_ChunkCapacity = 0;
+		QuadVertex* m_OwnedVertices = nullptr;
+		QuadVertex* m_Vertices = nullptr; // m_OwnedVertices or the target of the current build
+
+		// Per build state
+		const TaskFn* m_Task = nullptr;
+		uint32_t m_TaskCount = 0;
+		std::vector<std::vector<QuadChunk>> m_TaskChunks;
+		std::vector<QuadChunk> m_Chunks;
+		uint32_t m_QuadCount = 0;
+
+		// Each on its own cache line, every thread hammers them
+		alignas(64) std::atomic<uint32_t> m_NextTask{ 0 };
+		alignas(64) std::atomic<uint32_t> m_NextChunk{ 0 };
+		alignas(64) std::atomic<uint32_t> m_DroppedQuadCount{ 0 };
+
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeCondition;
+		std::condition_variable m_DoneCondition;
+		uint64_t m_Generation = 0;
+		uint32_t m_PendingWorkers = 0;
+		bool m_Stop = false;
+
+		friend class QuadWriter;
+	};
+
+}
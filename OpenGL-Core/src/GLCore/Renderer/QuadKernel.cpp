@@ -0,0 +1,429 @@
+#include "glpch.h"
+#include "QuadKernel.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define GLCORE_QUAD_KERNEL_X64
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define GLCORE_TARGET_AVX2
+	#else
+		#include <cpuid.h>
+		#define GLCORE_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+// The SIMD kernels spell out every mul and add; keep the compiler from fusing
+// the scalar ones into FMAs (e.g. under /arch:AVX2 or -mfma) so all ISAs
+// produce the same bits and VerifyQuadKernels can compare them exactly
+#if defined(_MSC_VER)
+	#pragma fp_contract(off)
+#elif defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+	#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace GLCore {
+
+	// Cephes style sin/cos: reduce to [-pi/4, pi/4] around the nearest multiple
+	// of pi/2 (three part constant for precision), evaluate both minimax
+	// polynomials, then pick/negate by quadrant. The SIMD kernels below are a
+	// lane-wise copy of this function.
+	static const float s_TwoOverPi = 0.636619772367581343f;
+	static const float s_PiOverTwo1 = 1.5703125f;
+	static const float s_PiOverTwo2 = 4.837512969970703125e-4f;
+	static const float s_PiOverTwo3 = 7.54978995489188216e-8f;
+	static const float s_Sin1 = -1.6666654611e-1f, s_Sin2 = 8.3321608736e-3f, s_Sin3 = -1.9515295891e-4f;
+	static const float s_Cos1 = 4.166664568298827e-2f, s_Cos2 = -1.388731625493765e-3f, s_Cos3 = 2.443315711809948e-5f;
+
+	// Corner offsets in vertex order (matches WriteQuadVertices)
+	static const float s_CornerX[4] = { -0.5f, 0.5f, 0.5f, -0.5f };
+	static const float s_CornerY[4] = { -0.5f, -0.5f, 0.5f, 0.5f };
+
+	static void SinCos(float x, float& outSin, float& outCos)
+	{
+		int32_t q = (int32_t)std::nearbyint(x * s_TwoOverPi);
+		float fq = (float)q;
+		float r = ((x - fq * s_PiOverTwo1) - fq * s_PiOverTwo2) - fq * s_PiOverTwo3;
+		float r2 = r * r;
+
+		float sinR = r + r * r2 * (s_Sin1 + r2 * (s_Sin2 + r2 * s_Sin3));
+		float cosR = (1.0f - 0.5f * r2) + r2 * r2 * (s_Cos1 + r2 * (s_Cos2 + r2 * s_Cos3));
+
+		bool swap = (q & 1) != 0;
+		float s = swap ? cosR : sinR;
+		float c = swap ? sinR : cosR;
+		outSin = (q & 2) ? -s : s;
+		outCos = ((q + 1) & 2) ? -c : c;
+	}
+
+	// Everything that is not position math is the same for all ISAs
+	static void WriteQuadAttributes(const QuadKernelInput& input, uint32_t index, QuadVertex* target)
+	{
+		const glm::vec4 color = input.Color ? input.Color[index] : glm::vec4(1.0f);
+		const glm::vec4 rect = input.TexCoordRect ? input.TexCoordRect[index] : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		const float z = input.PositionZ ? input.PositionZ[index] : 0.0f;
+		const float texIndex = input.TexIndex ? input.TexIndex[index] : input.ConstantTexIndex;
+
+		target[0].TexCoord = { rect.x, rect.y };
+		target[1].TexCoord = { rect.z, rect.y };
+		target[2].TexCoord = { rect.z, rect.w };
+		target[3].TexCoord = { rect.x, rect.w };
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			target[i].Position.z = z;
+			target[i].Color = color;
+			target[i].TexIndex = texIndex;
+		}
+	}
+
+	static void GenerateScalar(const QuadKernelInput& input, uint32_t begin, QuadVertex* target)
+	{
+		for (uint32_t i = begin; i < input.Count; i++)
+		{
+			float s = 0.0f, c = 1.0f;
+			if (input.Rotation)
+				SinCos(input.Rotation[i], s, c);
+
+			QuadVertex* quad = target + i * 4;
+			for (uint32_t corner = 0; corner < 4; corner++)
+			{
+				float lx = s_CornerX[corner] * input.SizeX[i];
+				float ly = s_CornerY[corner] * input.SizeY[i];
+				quad[corner].Position.x = input.PositionX[i] + (lx * c - ly * s);
+				quad[corner].Position.y = input.PositionY[i] + (lx * s + ly * c);
+			}
+			WriteQuadAttributes(input, i, quad);
+		}
+	}
+
+#ifdef GLCORE_QUAD_KERNEL_X64
+
+	static void SinCosSSE2(__m128 x, __m128& outSin, __m128& outCos)
+	{
+		__m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(s_TwoOverPi))); // round to nearest even
+		__m128 fq = _mm_cvtepi32_ps(q);
+		__m128 r = _mm_sub_ps(x, _mm_mul_ps(fq, _mm_set1_ps(s_PiOverTwo1)));
+		r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(s_PiOverTwo2)));
+		r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(s_PiOverTwo3)));
+		__m128 r2 = _mm_mul_ps(r, r);
+
+		__m128 sinPoly = _mm_add_ps(_mm_set1_ps(s_Sin2), _mm_mul_ps(r2, _mm_set1_ps(s_Sin3)));
+		sinPoly = _mm_add_ps(_mm_set1_ps(s_Sin1), _mm_mul_ps(r2, sinPoly));
+		__m128 sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sinPoly));
+
+		__m128 cosPoly = _mm_add_ps(_mm_set1_ps(s_Cos2), _mm_mul_ps(r2, _mm_set1_ps(s_Cos3)));
+		cosPoly = _mm_add_ps(_mm_set1_ps(s_Cos1), _mm_mul_ps(r2, cosPoly));
+		__m128 cosR = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_mul_ps(_mm_mul_ps(r2, r2), cosPoly));
+
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i two = _mm_set1_epi32(2);
+		__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+		__m128 s = _mm_or_ps(_mm_and_ps(swap, cosR), _mm_andnot_ps(swap, sinR));
+		__m128 c = _mm_or_ps(_mm_and_ps(swap, sinR), _mm_andnot_ps(swap, cosR));
+
+		// (q & 2) << 30 moves the quadrant bit into the float sign bit
+		__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+		__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+		outSin = _mm_xor_ps(s, sinSign);
+		outCos = _mm_xor_ps(c, cosSign);
+	}
+
+	static uint32_t GenerateSSE2(const QuadKernelInput& input, QuadVertex* target)
+	{
+		const uint32_t count = input.Count & ~3u;
+		alignas(16) float x[4][4], y[4][4];
+
+		for (uint32_t i = 0; i < count; i += 4)
+		{
+			__m128 px = _mm_loadu_ps(input.PositionX + i);
+			__m128 py = _mm_loadu_ps(input.PositionY + i);
+			__m128 sx = _mm_loadu_ps(input.SizeX + i);
+			__m128 sy = _mm_loadu_ps(input.SizeY + i);
+
+			__m128 s = _mm_setzero_ps(), c = _mm_set1_ps(1.0f);
+			if (input.Rotation)
+				SinCosSSE2(_mm_loadu_ps(input.Rotation + i), s, c);
+
+			for (uint32_t corner = 0; corner < 4; corner++)
+			{
+				__m128 lx = _mm_mul_ps(_mm_set1_ps(s_CornerX[corner]), sx);
+				__m128 ly = _mm_mul_ps(_mm_set1_ps(s_CornerY[corner]), sy);
+				_mm_store_ps(x[corner], _mm_add_ps(px, _mm_sub_ps(_mm_mul_ps(lx, c), _mm_mul_ps(ly, s))));
+				_mm_store_ps(y[corner], _mm_add_ps(py, _mm_add_ps(_mm_mul_ps(lx, s), _mm_mul_ps(ly, c))));
+			}
+
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				QuadVertex* quad = target + (i + lane) * 4;
+				for (uint32_t corner = 0; corner < 4; corner++)
+				{
+					quad[corner].Position.x = x[corner][lane];
+					quad[corner].Position.y = y[corner][lane];
+				}
+				WriteQuadAttributes(input, i + lane, quad);
+			}
+		}
+
+		return count;
+	}
+
+	GLCORE_TARGET_AVX2 static void SinCosAVX2(__m256 x, __m256& outSin, __m256& outCos)
+	{
+		__m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(s_TwoOverPi)));
+		__m256 fq = _mm256_cvtepi32_ps(q);
+		__m256 r = _mm256_sub_ps(x, _mm256_mul_ps(fq, _mm256_set1_ps(s_PiOverTwo1)));
+		r = _mm256_sub_ps(r, _mm256_mul_ps(fq, _mm256_set1_ps(s_PiOverTwo2)));
+		r = _mm256_sub_ps(r, _mm256_mul_ps(fq, _mm256_set1_ps(s_PiOverTwo3)));
+		__m256 r2 = _mm256_mul_ps(r, r);
+
+		__m256 sinPoly = _mm256_add_ps(_mm256_set1_ps(s_Sin2), _mm256_mul_ps(r2, _mm256_set1_ps(s_Sin3)));
+		sinPoly = _mm256_add_ps(_mm256_set1_ps(s_Sin1), _mm256_mul_ps(r2, sinPoly));
+		__m256 sinR = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), sinPoly));
+
+		__m256 cosPoly = _mm256_add_ps(_mm256_set1_ps(s_Cos2), _mm256_mul_ps(r2, _mm256_set1_ps(s_Cos3)));
+		cosPoly = _mm256_add_ps(_mm256_set1_ps(s_Cos1), _mm256_mul_ps(r2, cosPoly));
+		__m256 cosR = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), r2)), _mm256_mul_ps(_mm256_mul_ps(r2, r2), cosPoly));
+
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i two = _mm256_set1_epi32(2);
+		__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+		__m256 s = _mm256_blendv_ps(sinR, cosR, swap);
+		__m256 c = _mm256_blendv_ps(cosR, sinR, swap);
+
+		__m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, two), 30));
+		__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30));
+		outSin = _mm256_xor_ps(s, sinSign);
+		outCos = _mm256_xor_ps(c, cosSign);
+	}
+
+	GLCORE_TARGET_AVX2 static uint32_t GenerateAVX2(const QuadKernelInput& input, QuadVertex* target)
+	{
+		const uint32_t count = input.Count & ~7u;
+		alignas(32) float x[4][8], y[4][8];
+
+		for (uint32_t i = 0; i < count; i += 8)
+		{
+			__m256 px = _mm256_loadu_ps(input.PositionX + i);
+			__m256 py = _mm256_loadu_ps(input.PositionY + i);
+			__m256 sx = _mm256_loadu_ps(input.SizeX + i);
+			__m256 sy = _mm256_loadu_ps(input.SizeY + i);
+
+			__m256 s = _mm256_setzero_ps(), c = _mm256_set1_ps(1.0f);
+			if (input.Rotation)
+				SinCosAVX2(_mm256_loadu_ps(input.Rotation + i), s, c);
+
+			for (uint32_t corner = 0; corner < 4; corner++)
+			{
+				__m256 lx = _mm256_mul_ps(_mm256_set1_ps(s_CornerX[corner]), sx);
+				__m256 ly = _mm256_mul_ps(_mm256_set1_ps(s_CornerY[corner]), sy);
+				_mm256_store_ps(x[corner], _mm256_add_ps(px, _mm256_sub_ps(_mm256_mul_ps(lx, c), _mm256_mul_ps(ly, s))));
+				_mm256_store_ps(y[corner], _mm256_add_ps(py, _mm256_add_ps(_mm256_mul_ps(lx, s), _mm256_mul_ps(ly, c))));
+			}
+
+			// WriteQuadAttributes is plain SSE code, avoid the AVX-SSE transition penalty
+			_mm256_zeroupper();
+
+			for (uint32_t lane = 0; lane < 8; lane++)
+			{
+				QuadVertex* quad = target + (i + lane) * 4;
+				for (uint32_t corner = 0; corner < 4; corner++)
+				{
+					quad[corner].Position.x = x[corner][lane];
+					quad[corner].Position.y = y[corner][lane];
+				}
+				WriteQuadAttributes(input, i + lane, quad);
+			}
+		}
+
+		return count;
+	}
+
+	static QuadKernelISA DetectQuadKernelISA()
+	{
+		// SSE2 is part of x64; AVX2 also needs OS support for the YMM state
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return QuadKernelISA::SSE2;
+
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return QuadKernelISA::SSE2;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) ? QuadKernelISA::AVX2 : QuadKernelISA::SSE2;
+	#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? QuadKernelISA::AVX2 : QuadKernelISA::SSE2;
+	#endif
+	}
+
+#else
+
+	static QuadKernelISA DetectQuadKernelISA()
+	{
+		return QuadKernelISA::Scalar;
+	}
+
+#endif
+
+	QuadKernelInput QuadKernelInput::Slice(uint32_t offset, uint32_t count) const
+	{
+		QuadKernelInput result = *this;
+		auto advance = [offset](auto*& ptr) { if (ptr) ptr += offset; };
+		advance(result.PositionX);
+		advance(result.PositionY);
+		advance(result.PositionZ);
+		advance(result.SizeX);
+		advance(result.SizeY);
+		advance(result.Rotation);
+		advance(result.Color);
+		advance(result.TexCoordRect);
+		advance(result.TexIndex);
+		result.Count = count;
+		return result;
+	}
+
+	QuadKernelISA GetSupportedQuadKernelISA()
+	{
+		static QuadKernelISA s_ISA = DetectQuadKernelISA();
+		return s_ISA;
+	}
+
+	const char* GetQuadKernelISAName(QuadKernelISA isa)
+	{
+		switch (isa)
+		{
+		case QuadKernelISA::Scalar: return "Scalar";
+		case QuadKernelISA::SSE2:   return "SSE2";
+		case QuadKernelISA::AVX2:   return "AVX2";
+		}
+		return "Unknown";
+	}
+
+	void GenerateQuadVertices(const QuadKernelInput& input, QuadVertex* target)
+	{
+		GenerateQuadVertices(GetSupportedQuadKernelISA(), input, target);
+	}
+
+	void GenerateQuadVertices(QuadKernelISA isa, const QuadKernelInput& input, QuadVertex* target)
+	{
+		// Never run an ISA the CPU lacks, even if asked to
+		if ((int)isa > (int)GetSupportedQuadKernelISA())
+			isa = GetSupportedQuadKernelISA();
+
+		uint32_t done = 0;
+	#ifdef GLCORE_QUAD_KERNEL_X64
+		if (isa == QuadKernelISA::AVX2)
+			done = GenerateAVX2(input, target);
+		else if (isa == QuadKernelISA::SSE2)
+			done = GenerateSSE2(input, target);
+	#endif
+
+		// Remainder that does not fill a whole SIMD register
+		GenerateScalar(input, done, target);
+	}
+
+	// Distance in representable floats; -0 and +0 are the same value
+	static uint32_t UlpDistance(float a, float b)
+	{
+		int32_t bitsA, bitsB;
+		memcpy(&bitsA, &a, sizeof(float));
+		memcpy(&bitsB, &b, sizeof(float));
+		int64_t orderedA = bitsA < 0 ? (int64_t)INT32_MIN - bitsA : bitsA;
+		int64_t orderedB = bitsB < 0 ? (int64_t)INT32_MIN - bitsB : bitsB;
+		return (uint32_t)std::min<int64_t>(std::abs(orderedA - orderedB), UINT32_MAX);
+	}
+
+	bool VerifyQuadKernels(uint32_t maxUlps)
+	{
+		static_assert(sizeof(QuadVertex) % sizeof(float) == 0, "QuadVertex is compared float by float");
+		const uint32_t floatsPerQuad = 4 * (uint32_t)(sizeof(QuadVertex) / sizeof(float));
+
+		// A fixed LCG rather than <random>, whose distributions differ between standard libraries
+		uint32_t state = 1337;
+		auto next = [&state](float min, float max)
+		{
+			state = state * 1664525u + 1013904223u;
+			return min + (max - min) * (float)(state >> 8) * (1.0f / 16777216.0f);
+		};
+
+		const uint32_t maxCount = 1031;
+		std::vector<float> positionX(maxCount), positionY(maxCount), positionZ(maxCount), sizeX(maxCount), sizeY(maxCount), rotation(maxCount);
+		std::vector<float> texIndex(maxCount);
+		std::vector<glm::vec4> colors(maxCount), texCoordRects(maxCount);
+		for (uint32_t i = 0; i < maxCount; i++)
+		{
+			positionX[i] = next(-1000.0f, 1000.0f);
+			positionY[i] = next(-1000.0f, 1000.0f);
+			positionZ[i] = next(-1.0f, 1.0f);
+			sizeX[i] = next(0.01f, 64.0f);
+			sizeY[i] = next(0.01f, 64.0f);
+			rotation[i] = next(-100.0f, 100.0f);
+			colors[i] = { next(0.0f, 1.0f), next(0.0f, 1.0f), next(0.0f, 1.0f), 1.0f };
+			texCoordRects[i] = { next(0.0f, 0.5f), next(0.0f, 0.5f), next(0.5f, 1.0f), next(0.5f, 1.0f) };
+			texIndex[i] = (float)(i % 32);
+		}
+		// Zero and quadrant boundaries, where the range reduction rounds differently if anything is off
+		const float specialAngles[] = { 0.0f, -0.0f, 0.78539816f, -0.78539816f, 1.57079633f, 3.14159265f, -3.14159265f, 4.71238898f };
+		for (uint32_t i = 0; i < sizeof(specialAngles) / sizeof(float); i++)
+			rotation[i] = specialAngles[i];
+
+		QuadKernelInput input;
+		input.PositionX = positionX.data();
+		input.PositionY = positionY.data();
+		input.PositionZ = positionZ.data();
+		input.SizeX = sizeX.data();
+		input.SizeY = sizeY.data();
+		input.Rotation = rotation.data();
+		input.Color = colors.data();
+		input.TexCoordRect = texCoordRects.data();
+		input.TexIndex = texIndex.data();
+		input.ConstantTexIndex = 3.0f;
+
+		std::vector<QuadVertex> expected(maxCount * 4), actual(maxCount * 4);
+		bool passed = true;
+		for (uint32_t isa = (uint32_t)QuadKernelISA::SSE2; isa <= (uint32_t)GetSupportedQuadKernelISA(); isa++)
+		{
+			for (uint32_t count : { 1u, 3u, 4u, 7u, 8u, 9u, 15u, 17u, 33u, 100u, maxCount })
+			{
+				// Once with every array, once with only the required ones so the defaults are covered
+				for (bool optional : { true, false })
+				{
+					QuadKernelInput run = input;
+					run.Count = count;
+					if (!optional)
+					{
+						run.PositionZ = run.Rotation = run.TexIndex = nullptr;
+						run.Color = run.TexCoordRect = nullptr;
+					}
+
+					GenerateQuadVertices(QuadKernelISA::Scalar, run, expected.data());
+					GenerateQuadVertices((QuadKernelISA)isa, run, actual.data());
+
+					const float* expectedFloats = (const float*)expected.data();
+					const float* actualFloats = (const float*)actual.data();
+					for (uint32_t i = 0; i < count * floatsPerQuad; i++)
+					{
+						if (UlpDistance(expectedFloats[i], actualFloats[i]) <= maxUlps)
+							continue;
+
+						LOG_ERROR("{0} quad kernel differs from Scalar: {1} sprites, sprite {2}, float {3}: {4} vs {5}", GetQuadKernelISAName((QuadKernelISA)isa),
+							count, i / floatsPerQuad, i % floatsPerQuad, actualFloats[i], expectedFloats[i]);
+						passed = false;
+						break;
+					}
+				}
+			}
+		}
+		return passed;
+	}
+
+}
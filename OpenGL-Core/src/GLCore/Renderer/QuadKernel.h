@@ -0,0 +1,50 @@
+#pragma once
+
+#include "QuadVertex.h"
+
+namespace GLCore {
+
+	// Structure-of-arrays sprite data for bulk vertex generation. Every
+	// non-null array holds Count entries; optional arrays fall back to the
+	// value noted next to them.
+	struct QuadKernelInput
+	{
+		const float* PositionX = nullptr;
+		const float* PositionY = nullptr;
+		const float* PositionZ = nullptr;       // optional, 0
+		const float* SizeX = nullptr;
+		const float* SizeY = nullptr;
+		const float* Rotation = nullptr;        // optional, radians counter-clockwise, 0
+		const glm::vec4* Color = nullptr;       // optional, white
+		const glm::vec4* TexCoordRect = nullptr; // optional, (min.x, min.y, max.x, max.y), full texture
+		const float* TexIndex = nullptr;        // optional, ConstantTexIndex
+		float ConstantTexIndex = 0.0f;
+		uint32_t Count = 0;
+
+		// Sprites [offset, offset + count) of this input
+		QuadKernelInput Slice(uint32_t offset, uint32_t count) const;
+	};
+
+	enum class QuadKernelISA
+	{
+		Scalar = 0, SSE2, AVX2
+	};
+
+	// Best instruction set supported by this CPU, detected once at startup
+	QuadKernelISA GetSupportedQuadKernelISA();
+	const char* GetQuadKernelISAName(QuadKernelISA isa);
+
+	// Writes Count * 4 Standard quad vertices (rotated/scaled around each
+	// sprite's center) to target. All ISAs use the same sin/cos approximation,
+	// so results only differ by floating point rounding.
+	void GenerateQuadVertices(const QuadKernelInput& input, QuadVertex* target);
+	void GenerateQuadVertices(QuadKernelISA isa, const QuadKernelInput& input, QuadVertex* target);
+
+	// Runs every supported SIMD kernel on fixed pseudo-random sprites, with
+	// counts that are not multiples of 8 so the scalar tail runs too, and
+	// compares each vertex float with the Scalar kernel's. Anything further
+	// apart than maxUlps is logged and fails the check. Asserted at startup in
+	// Debug builds.
+	bool VerifyQuadKernels(uint32_t maxUlps = 2);
+
+}
@@ -0,0 +1,162 @@
+#include "glpch.h"
+#include "QuadVertex.h"
+
+#include "VertexArray.h"
+
+#include <glm/packing.hpp>
+
+namespace GLCore {
+
+	uint32_t GetQuadVertexSize(QuadVertexFormat format)
+	{
+		switch (format)
+		{
+		case QuadVertexFormat::Standard:    return sizeof(QuadVertex);
+		case QuadVertexFormat::Compact:     return sizeof(CompactQuadVertex);
+		case QuadVertexFormat::CompactHalf: return sizeof(CompactHalfQuadVertex);
+		}
+		return 0;
+	}
+
+	const char* GetQuadVertexFormatName(QuadVertexFormat format)
+	{
+		switch (format)
+		{
+		case QuadVertexFormat::Standard:    return "Standard";
+		case QuadVertexFormat::Compact:     return "Compact";
+		case QuadVertexFormat::CompactHalf: return "CompactHalf";
+		}
+		return "Unknown";
+	}
+
+	const BufferLayout& GetQuadVertexLayout(QuadVertexFormat format)
+	{
+		static const BufferLayout s_StandardLayout = BufferLayout::Create<QuadVertex>({
+			GLCORE_VERTEX_ELEMENT(QuadVertex, Position),
+			GLCORE_VERTEX_ELEMENT(QuadVertex, Color),
+			GLCORE_VERTEX_ELEMENT(QuadVertex, TexCoord),
+			GLCORE_VERTEX_ELEMENT(QuadVertex, TexIndex)
+		});
+		static const BufferLayout s_CompactLayout = BufferLayout::Create<CompactQuadVertex>({
+			GLCORE_VERTEX_ELEMENT(CompactQuadVertex, Position),
+			GLCORE_VERTEX_ELEMENT_AS(CompactQuadVertex, Color, VertexElementType::UNorm8x4),
+			GLCORE_VERTEX_ELEMENT_AS(CompactQuadVertex, TexCoord, VertexElementType::UNorm16x2),
+			GLCORE_VERTEX_ELEMENT_AS(CompactQuadVertex, TexIndex, VertexElementType::UIntToFloat)
+		});
+		static const BufferLayout s_CompactHalfLayout = BufferLayout::Create<CompactHalfQuadVertex>({
+			GLCORE_VERTEX_ELEMENT_AS(CompactHalfQuadVertex, Position, VertexElementType::Half2),
+			GLCORE_VERTEX_ELEMENT_AS(CompactHalfQuadVertex, Color, VertexElementType::UNorm8x4),
+			GLCORE_VERTEX_ELEMENT_AS(CompactHalfQuadVertex, TexCoord, VertexElementType::UNorm16x2),
+			GLCORE_VERTEX_ELEMENT_AS(CompactHalfQuadVertex, TexIndex, VertexElementType::UIntToFloat)
+		});
+
+		switch (format)
+		{
+		case QuadVertexFormat::Standard:    return s_StandardLayout;
+		case QuadVertexFormat::Compact:     return s_CompactLayout;
+		case QuadVertexFormat::CompactHalf: return s_CompactHalfLayout;
+		}
+		return s_StandardLayout;
+	}
+
+	void SetQuadVertexAttributes(GLuint vertexArray, QuadVertexFormat format)
+	{
+		VertexArray::ApplyLayout(vertexArray, GetQuadVertexLayout(format), 0);
+	}
+
+	uint8_t* WriteQuadVertices(QuadVertexFormat format, uint8_t* target, const glm::vec3& position, const glm::vec2& size,
+		const glm::vec4& color, float textureIndex, const glm::vec2& texCoordMin, const glm::vec2& texCoordMax)
+	{
+		const float halfWidth = size.x * 0.5f;
+		const float halfHeight = size.y * 0.5f;
+		const float x0 = position.x - halfWidth, x1 = position.x + halfWidth;
+		const float y0 = position.y - halfHeight, y1 = position.y + halfHeight;
+
+		switch (format)
+		{
+		case QuadVertexFormat::Standard:
+		{
+			const glm::vec3 positions[] = { { x0, y0, position.z }, { x1, y0, position.z }, { x1, y1, position.z }, { x0, y1, position.z } };
+			const glm::vec2 texCoords[] = {
+				{ texCoordMin.x, texCoordMin.y }, { texCoordMax.x, texCoordMin.y },
+				{ texCoordMax.x, texCoordMax.y }, { texCoordMin.x, texCoordMax.y }
+			};
+
+			QuadVertex* vertex = (QuadVertex*)target;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				vertex->Position = positions[i];
+				vertex->Color = color;
+				vertex->TexCoord = texCoords[i];
+				vertex->TexIndex = textureIndex;
+				vertex++;
+			}
+			return (uint8_t*)vertex;
+		}
+		case QuadVertexFormat::Compact:
+		case QuadVertexFormat::CompactHalf:
+		{
+			// Quantize once per quad, not per vertex
+			const uint32_t packedColor = glm::packUnorm4x8(color);
+			const uint32_t uvMin = glm::packUnorm2x16(texCoordMin);
+			const uint32_t uvMax = glm::packUnorm2x16(texCoordMax);
+			const uint16_t u[] = { (uint16_t)uvMin, (uint16_t)uvMax, (uint16_t)uvMax, (uint16_t)uvMin };
+			const uint16_t v[] = { (uint16_t)(uvMin >> 16), (uint16_t)(uvMin >> 16), (uint16_t)(uvMax >> 16), (uint16_t)(uvMax >> 16) };
+			const uint32_t texIndex = (uint32_t)textureIndex;
+
+			if (format == QuadVertexFormat::Compact)
+			{
+				const glm::vec2 positions[] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+
+				CompactQuadVertex* vertex = (CompactQuadVertex*)target;
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					vertex->Position = positions[i];
+					vertex->Color = packedColor;
+					vertex->TexCoord[0] = u[i];
+					vertex->TexCoord[1] = v[i];
+					vertex->TexIndex = texIndex;
+					vertex++;
+				}
+				return (uint8_t*)vertex;
+			}
+
+			const uint32_t bottomLeft = glm::packHalf2x16({ x0, y0 });
+			const uint32_t topRight = glm::packHalf2x16({ x1, y1 });
+			const uint16_t px[] = { (uint16_t)bottomLeft, (uint16_t)topRight, (uint16_t)topRight, (uint16_t)bottomLeft };
+			const uint16_t py[] = { (uint16_t)(bottomLeft >> 16), (uint16_t)(bottomLeft >> 16), (uint16_t)(topRight >> 16), (uint16_t)(topRight >> 16) };
+
+			CompactHalfQuadVertex* vertex = (CompactHalfQuadVertex*)target;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				vertex->Position[0] = px[i];
+				vertex->Position[1] = py[i];
+				vertex->Color = packedColor;
+				vertex->TexCoord[0] = u[i];
+				vertex->TexCoord[1] = v[i];
+				vertex->TexIndex = texIndex;
+				vertex++;
+			}
+			return (uint8_t*)vertex;
+		}
+		}
+
+		return target;
+	}
+
+	uint8_t* WriteQuadSprite(uint8_t* target, const glm::vec3& position, const glm::vec2& size,
+		const glm::vec4& color, float textureIndex, const glm::vec2& texCoordMin, const glm::vec2& texCoordMax)
+	{
+		QuadSprite* sprite = (QuadSprite*)target;
+		sprite->Position = { position.x, position.y };
+		sprite->Size = size;
+		sprite->Depth = position.z;
+		sprite->Color = glm::packUnorm4x8(color);
+		sprite->TexCoordMin = glm::packUnorm2x16(texCoordMin);
+		sprite->TexCoordMax = glm::packUnorm2x16(texCoordMax);
+		sprite->TexIndex = (uint32_t)textureIndex;
+		sprite->Padding = 0;
+		return (uint8_t*)(sprite + 1);
+	}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Buffer.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace GLCore {
+
+	enum class QuadVertexFormat
+	{
+		Standard = 0, // 40 bytes: vec3 position, vec4 color, vec2 uv, float texture index
+		Compact,      // 20 bytes: vec2 position, RGBA8 color, unorm16 uv, uint texture index
+		CompactHalf   // 16 bytes: half2 position, RGBA8 color, unorm16 uv, uint texture index
+	};
+
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TexCoord;
+		float TexIndex;
+	};
+
+	// The compact formats drop position.z (draw order decides overlap) and
+	// quantize everything else; the attribute setup converts back to floats
+	// so all formats share the same shader.
+	struct CompactQuadVertex
+	{
+		glm::vec2 Position;
+		uint32_t Color;
+		uint16_t TexCoord[2];
+		uint32_t TexIndex;
+	};
+
+	// Half floats hold 11 significant bits, so keep positions within a few hundred units of the origin
+	struct CompactHalfQuadVertex
+	{
+		uint16_t Position[2];
+		uint32_t Color;
+		uint16_t TexCoord[2];
+		uint32_t TexIndex;
+	};
+
+	// One struct per quad for the vertex pulling path; mirrors the std430
+	// Sprite struct in the shader, which expands the corners from gl_VertexID
+	struct QuadSprite
+	{
+		glm::vec2 Position;
+		glm::vec2 Size;
+		float Depth;
+		uint32_t Color;       // RGBA8
+		uint32_t TexCoordMin; // unorm16x2
+		uint32_t TexCoordMax; // unorm16x2
+		uint32_t TexIndex;
+		uint32_t Padding;
+	};
+
+	static_assert(sizeof(QuadVertex) == 40, "Unexpected QuadVertex size");
+	static_assert(sizeof(CompactQuadVertex) == 20, "Unexpected CompactQuadVertex size");
+	static_assert(sizeof(CompactHalfQuadVertex) == 16, "Unexpected CompactHalfQuadVertex size");
+	static_assert(sizeof(QuadSprite) == 40, "QuadSprite must match the std430 layout");
+
+	uint32_t GetQuadVertexSize(QuadVertexFormat format);
+	const char* GetQuadVertexFormatName(QuadVertexFormat format);
+
+	// Attributes 0-3 (position, color, uv, texture index) as seen by the quad shader
+	const BufferLayout& GetQuadVertexLayout(QuadVertexFormat format);
+	// Configures attributes 0-3 of vertexArray for format, sourcing from binding 0
+	void SetQuadVertexAttributes(GLuint vertexArray, QuadVertexFormat format);
+
+	// Writes the four corners of an axis-aligned quad centered on position and
+	// returns the pointer just past them
+	uint8_t* WriteQuadVertices(QuadVertexFormat format, uint8_t* target, const glm::vec3& position, const glm::vec2& size,
+		const glm::vec4& color, float textureIndex, const glm::vec2& texCoordMin, const glm::vec2& texCoordMax);
+
+	// Writes one QuadSprite and returns the pointer just past it
+	uint8_t* WriteQuadSprite(uint8_t* target, const glm::vec3& position, const glm::vec2& size,
+		const glm::vec4& color, float textureIndex, const glm::vec2& texCoordMin, const glm::vec2& texCoordMax);
+
+}
@@ -0,0 +1,291 @@
+#include "glpch.h"
+#include "RenderQueue.h"
+
+#include "MultiDrawIndirect.h"
+#include "StreamBuffer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+
+#include "GLCore/Util/Timer.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace GLCore {
+
+	// std430 layout of one DrawData entry
+	struct DrawData
+	{
+		glm::mat4 Transform;
+		glm::vec4 Color;
+	};
+
+	struct RenderQueueData
+	{
+		// Linear per-frame storage, cleared but never shrunk
+		std::vector<DrawCommand> Commands;
+		std::vector<uint64_t> Keys;
+		std::vector<uint32_t> Cameras; // FrameUniforms camera index per command
+		std::vector<uint32_t> Order;
+		std::vector<uint64_t> KeyScratch;
+		std::vector<uint32_t> OrderScratch;
+
+		// Multi-draw path
+		GLuint DrawIndexBuffer = 0;
+		std::unique_ptr<StreamBuffer> IndirectStream;
+		std::unique_ptr<StreamBuffer> DrawDataStream;
+		uint32_t StorageBufferAlignment = 1;
+		std::vector<DrawElementsIndirectCommand> IndirectCommands;
+		std::vector<DrawData> DrawDataStaging;
+
+		RenderQueue::Statistics Stats;
+	};
+
+	static RenderQueueData s_QueueData;
+
+	static const uint32_t s_DepthBits = 24;
+	static const uint32_t s_MaxDepth = (1u << s_DepthBits) - 1;
+
+	void RenderQueue::Init()
+	{
+		s_QueueData.Commands.reserve(4096);
+		s_QueueData.Keys.reserve(4096);
+		s_QueueData.Cameras.reserve(4096);
+
+		GLint storageAlignment = 1;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+		s_QueueData.StorageBufferAlignment = (uint32_t)storageAlignment;
+
+		s_QueueData.DrawIndexBuffer = MultiDrawIndirect::CreateDrawIndexBuffer(MaxDrawsPerMultiDraw);
+		s_QueueData.IndirectStream = std::make_unique<StreamBuffer>(MaxDrawsPerMultiDraw * (uint32_t)sizeof(DrawElementsIndirectCommand));
+		s_QueueData.DrawDataStream = std::make_unique<StreamBuffer>(MaxDrawsPerMultiDraw * (uint32_t)sizeof(DrawData) + s_QueueData.StorageBufferAlignment);
+		s_QueueData.IndirectCommands.reserve(MaxDrawsPerMultiDraw);
+		s_QueueData.DrawDataStaging.reserve(MaxDrawsPerMultiDraw);
+	}
+
+	void RenderQueue::Shutdown()
+	{
+		glDeleteBuffers(1, &s_QueueData.DrawIndexBuffer);
+		s_QueueData = RenderQueueData();
+	}
+
+	void RenderQueue::AttachDrawIndex(GLuint vertexArray, GLuint attribute, GLuint binding)
+	{
+		MultiDrawIndirect::AttachDrawIndexAttribute(vertexArray, s_QueueData.DrawIndexBuffer, attribute, binding);
+	}
+
+	// Can command index join a multi-draw started by first?
+	static bool CanMerge(uint32_t first, uint32_t index)
+	{
+		const DrawCommand& firstCommand = s_QueueData.Commands[first];
+		const DrawCommand& command = s_QueueData.Commands[index];
+		return command.UseDrawData && command.Indexed && command.Shader == firstCommand.Shader && command.VertexArray == firstCommand.VertexArray
+			&& command.Texture == firstCommand.Texture && command.Mode == firstCommand.Mode && s_QueueData.Cameras[index] == s_QueueData.Cameras[first];
+	}
+
+	// Issues the run of mergeable commands starting at order[begin], returns one past its end
+	static uint32_t SubmitMultiDraw(const std::vector<uint32_t>& order, uint32_t begin)
+	{
+		const DrawCommand& first = s_QueueData.Commands[order[begin]];
+
+		s_QueueData.IndirectCommands.clear();
+		s_QueueData.DrawDataStaging.clear();
+
+		uint32_t end = begin;
+		while (end < order.size() && s_QueueData.IndirectCommands.size() < RenderQueue::MaxDrawsPerMultiDraw)
+		{
+			if (!CanMerge(order[begin], order[end]))
+				break;
+
+			const DrawCommand& command = s_QueueData.Commands[order[end]];
+
+			// BaseInstance doubles as the index into the draw data
+			uint32_t drawIndex = (uint32_t)s_QueueData.IndirectCommands.size();
+			s_QueueData.IndirectCommands.push_back({ command.Count, 1, command.FirstIndex, command.BaseVertex, drawIndex });
+			s_QueueData.DrawDataStaging.push_back({ command.Transform, command.Color });
+			end++;
+		}
+
+		uint32_t drawCount = end - begin;
+		uint32_t dataSize = drawCount * (uint32_t)sizeof(DrawData);
+		uint32_t dataOffset = s_QueueData.DrawDataStream->Upload(s_QueueData.DrawDataStaging.data(), dataSize, s_QueueData.StorageBufferAlignment);
+		GLStateCache::BindBufferRange(GL_SHADER_STORAGE_BUFFER, RenderQueue::DrawDataBinding, s_QueueData.DrawDataStream->GetRendererID(), dataOffset, dataSize);
+
+		uint32_t indirectOffset = s_QueueData.IndirectStream->Upload(s_QueueData.IndirectCommands.data(),
+			drawCount * (uint32_t)sizeof(DrawElementsIndirectCommand), (uint32_t)sizeof(uint32_t));
+
+		s_QueueData.Stats.DrawCalls += MultiDrawIndirect::DrawElements(first.Mode, s_QueueData.IndirectStream->GetRendererID(),
+			indirectOffset, s_QueueData.IndirectCommands.data(), drawCount);
+		s_QueueData.Stats.MultiDraws++;
+
+		s_QueueData.DrawDataStream->Fence();
+		s_QueueData.IndirectStream->Fence();
+		return end;
+	}
+
+	uint64_t RenderQueue::EncodeKey(uint8_t layer, bool translucent, GLuint shader, GLuint texture, float depth)
+	{
+		uint64_t quantizedDepth = (uint64_t)(glm::clamp(depth, 0.0f, 1.0f) * s_MaxDepth);
+		uint64_t key = (uint64_t)layer << 56;
+
+		if (translucent)
+		{
+			key |= 1ull << 55;
+			key |= (s_MaxDepth - quantizedDepth) << 31;
+			key |= (uint64_t)(shader & 0xfff) << 19;
+			key |= (uint64_t)(texture & 0xffff) << 3;
+		}
+		else
+		{
+			key |= (uint64_t)(shader & 0xfff) << 43;
+			key |= (uint64_t)(texture & 0xffff) << 27;
+			key |= quantizedDepth << 3;
+		}
+		return key;
+	}
+
+	void RenderQueue::Submit(const DrawCommand& command, uint8_t layer, bool translucent, float depth)
+	{
+		s_QueueData.Keys.push_back(EncodeKey(layer, translucent, command.Shader, command.Texture, depth));
+		s_QueueData.Commands.push_back(command);
+		s_QueueData.Cameras.push_back(FrameUniforms::GetCameraIndex());
+	}
+
+	void RenderQueue::Flush()
+	{
+		s_QueueData.Stats = Statistics();
+
+		uint32_t count = (uint32_t)s_QueueData.Commands.size();
+		if (count == 0)
+			return;
+
+		Utils::Timer timer;
+		s_QueueData.Order.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			s_QueueData.Order[i] = i;
+		s_QueueData.KeyScratch.resize(count);
+		s_QueueData.OrderScratch.resize(count);
+		RadixSort(s_QueueData.Keys.data(), s_QueueData.Order.data(), s_QueueData.KeyScratch.data(), s_QueueData.OrderScratch.data(), count);
+		s_QueueData.Stats.SortTimeMs = timer.ElapsedMillis();
+
+		// Neighbouring commands mostly share state after sorting, only bind what changed
+		GLuint currentShader = 0, currentVertexArray = 0, currentTexture = 0;
+		uint32_t currentCamera = FrameUniforms::NoCamera;
+		const std::vector<uint32_t>& order = s_QueueData.Order;
+		for (uint32_t i = 0; i < count; )
+		{
+			const DrawCommand& command = s_QueueData.Commands[order[i]];
+
+			uint32_t camera = s_QueueData.Cameras[order[i]];
+			if (camera != currentCamera && camera != FrameUniforms::NoCamera)
+			{
+				FrameUniforms::BindCamera(camera);
+				currentCamera = camera;
+				s_QueueData.Stats.CameraBinds++;
+			}
+
+			if (command.Shader != currentShader)
+			{
+				GLStateCache::UseProgram(command.Shader);
+				currentShader = command.Shader;
+				s_QueueData.Stats.ProgramBinds++;
+			}
+			if (command.VertexArray != currentVertexArray)
+			{
+				GLStateCache::BindVertexArray(command.VertexArray);
+				currentVertexArray = command.VertexArray;
+				s_QueueData.Stats.VertexArrayBinds++;
+			}
+			if (command.Texture && command.Texture != currentTexture)
+			{
+				GLStateCache::BindTextureUnit(0, command.Texture);
+				currentTexture = command.Texture;
+				s_QueueData.Stats.TextureBinds++;
+			}
+
+			if (command.UseDrawData)
+			{
+				GLCORE_ASSERT(command.Indexed, "UseDrawData requires an indexed draw!");
+				i = SubmitMultiDraw(order, i);
+				continue;
+			}
+
+			if (command.TransformLocation >= 0)
+				glUniformMatrix4fv(command.TransformLocation, 1, GL_FALSE, glm::value_ptr(command.Transform));
+			if (command.ColorLocation >= 0)
+				glUniform4fv(command.ColorLocation, 1, glm::value_ptr(command.Color));
+
+			if (command.Indexed)
+				glDrawElementsBaseVertex(command.Mode, command.Count, GL_UNSIGNED_INT, (const void*)(uintptr_t)(command.FirstIndex * sizeof(uint32_t)), command.BaseVertex);
+			else
+				glDrawArrays(command.Mode, command.FirstIndex, command.Count);
+			s_QueueData.Stats.DrawCalls++;
+			i++;
+		}
+
+		// Leave the latest camera bound for whatever draws directly after the flush
+		FrameUniforms::BindCamera(FrameUniforms::GetCameraIndex());
+
+		s_QueueData.Stats.Commands = count;
+		s_QueueData.Commands.clear();
+		s_QueueData.Keys.clear();
+		s_QueueData.Cameras.clear();
+	}
+
+	const RenderQueue::Statistics& RenderQueue::GetStats()
+	{
+		return s_QueueData.Stats;
+	}
+
+	void RadixSort(uint64_t* keys, uint32_t* values, uint64_t* keyScratch, uint32_t* valueScratch, uint32_t count)
+	{
+		// All eight histograms in a single read of the keys
+		uint32_t histograms[8][256] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t key = keys[i];
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(key >> (pass * 8)) & 0xff]++;
+		}
+
+		uint64_t* sourceKeys = keys;
+		uint32_t* sourceValues = values;
+		uint64_t* targetKeys = keyScratch;
+		uint32_t* targetValues = valueScratch;
+
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			uint32_t* histogram = histograms[pass];
+			uint32_t shift = pass * 8;
+
+			// Every key has the same byte here, the pass would not move anything
+			if (histogram[(sourceKeys[0] >> shift) & 0xff] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < 256; bucket++)
+			{
+				uint32_t bucketCount = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t destination = histogram[(sourceKeys[i] >> shift) & 0xff]++;
+				targetKeys[destination] = sourceKeys[i];
+				targetValues[destination] = sourceValues[i];
+			}
+
+			std::swap(sourceKeys, targetKeys);
+			std::swap(sourceValues, targetValues);
+		}
+
+		// An odd number of passes leaves the result in the scratch buffers
+		if (sourceKeys != keys)
+		{
+			memcpy(keys, sourceKeys, count * sizeof(uint64_t));
+			memcpy(values, sourceValues, count * sizeof(uint32_t));
+		}
+	}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace GLCore {
+
+	// Everything needed to issue one draw. Per-draw uniforms are only set when
+	// their location is valid; anything else (view projection, ...) is expected
+	// to live in the program already, e.g. via glProgramUniform*.
+	struct DrawCommand
+	{
+		GLuint Shader = 0;
+		GLuint VertexArray = 0;
+		GLuint Texture = 0;        // bound to unit 0, 0 = leave as is
+		GLenum Mode = GL_TRIANGLES;
+		uint32_t Count = 0;        // index count, or vertex count when not Indexed
+		uint32_t FirstIndex = 0;   // first vertex when not Indexed
+		int32_t BaseVertex = 0;
+		bool Indexed = true;
+
+		// Transform and Color are read by the shader from the DrawData storage
+		// buffer instead of uniforms, indexed by the draw index attribute (see
+		// AttachDrawIndex). Consecutive indexed commands with the same state are
+		// then merged into a single multi-draw.
+		bool UseDrawData = false;
+
+		GLint TransformLocation = -1;
+		glm::mat4 Transform = glm::mat4(1.0f);
+		GLint ColorLocation = -1;
+		glm::vec4 Color = glm::vec4(1.0f);
+	};
+
+	// Deferred draw submission. Commands are recorded with a 64-bit sort key,
+	// radix sorted once per frame and executed with redundant program, vertex
+	// array and texture binds skipped. Key layout, most significant first:
+	//
+	//   opaque:      layer:8 | 0 | shader:12 | texture:16 | depth:24 (front to back) | 0:3
+	//   translucent: layer:8 | 1 | depth:24 (back to front) | shader:12 | texture:16 | 0:3
+	//
+	// Shader and texture names are truncated to their fields; a collision only
+	// costs a state change, the command always carries the full names.
+	//
+	// Each command also remembers the FrameUniforms camera that was current at
+	// Submit, which Flush binds before drawing it, so layers may set different
+	// cameras before their submits.
+	class RenderQueue
+	{
+	public:
+		// GLSL side of UseDrawData:
+		//   layout (location = N) in uint a_DrawIndex;
+		//   struct DrawData { mat4 Transform; vec4 Color; };
+		//   layout (std430, binding = 1) readonly buffer DrawDataBuffer { DrawData s_DrawData[]; };
+		static const GLuint DrawDataBinding = 1;
+		static const uint32_t MaxDrawsPerMultiDraw = 4096;
+
+		static void Init();
+		static void Shutdown();
+
+		// depth is in [0, 1], 0 being nearest the camera
+		static void Submit(const DrawCommand& command, uint8_t layer = 0, bool translucent = false, float depth = 0.0f);
+
+		// Sorts and executes everything submitted since the last flush; called by Application once per frame
+		static void Flush();
+
+		static uint64_t EncodeKey(uint8_t layer, bool translucent, GLuint shader, GLuint texture, float depth);
+
+		// Hooks the shared draw index buffer up to attribute of vertexArray (binding is a free vertex buffer binding)
+		static void AttachDrawIndex(GLuint vertexArray, GLuint attribute, GLuint binding);
+
+		struct Statistics
+		{
+			uint32_t Commands = 0;
+			uint32_t ProgramBinds = 0;
+			uint32_t VertexArrayBinds = 0;
+			uint32_t TextureBinds = 0;
+			uint32_t CameraBinds = 0;
+			uint32_t DrawCalls = 0;
+			uint32_t MultiDraws = 0;
+			float SortTimeMs = 0.0f;
+		};
+		static const Statistics& GetStats();
+	};
+
+	// Stable LSD radix sort of keys, 8 bits per pass. values is permuted along
+	// with the keys; passes where every key shares the same byte are skipped.
+	// keyScratch/valueScratch must hold count elements.
+	void RadixSort(uint64_t* keys, uint32_t* values, uint64_t* keyScratch, uint32_t* valueScratch, uint32_t count);
+
+}
@@ -0,0 +1,662 @@
+#include "glpch.h"
+#include "Renderer2D.h"
+
+#include "StreamBuffer.h"
+#include "TextureSlotManager.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "QuadVertex.h"
+#include "QuadKernel.h"
+
+#include "GLCore/Util/Shader.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace GLCore {
+
+	struct Renderer2DData
+	{
+		static const uint32_t MaxQuads = 10000;
+		static const uint32_t MaxVertices = MaxQuads * 4;
+		static const uint32_t MaxIndices = MaxQuads * 6;
+
+		GLuint QuadVA = 0;
+		GLuint QuadIB = 0;
+		GLuint WhiteTexture = 0;
+		std::unique_ptr<StreamBuffer> QuadVertexStream;
+
+		// ParallelQuadBuilder arenas, streamed whole and drawn chunk by chunk in one call
+		std::unique_ptr<StreamBuffer> BuilderVertexStream;
+		std::vector<GLsizei> ChunkIndexCounts;
+		std::vector<const void*> ChunkIndexOffsets;
+		std::vector<GLint> ChunkBaseVertices;
+
+		// Vertex pulling path: sprites are read from an SSBO, no vertex attributes or indices
+		GLuint SpriteVA = 0;
+		uint32_t StorageBufferAlignment = 1;
+
+		// Texture array instead of the slots, selected per batch
+		GLuint BatchTextureArray = 0; // 0 while the batch uses the texture slots
+
+		Renderer2DPath Path = Renderer2DPath::VertexBatch;
+		QuadVertexFormat VertexFormat = QuadVertexFormat::Standard;
+		uint32_t QuadIndexCount = 0;
+		uint8_t* QuadVertexBufferBase = nullptr;
+		uint8_t* QuadVertexBufferPtr = nullptr;
+
+		TextureSlotManager TextureSlots;
+
+		Renderer2D::Statistics Stats;
+	};
+
+	static Renderer2DData s_Data;
+
+	// Every program the renderer uses is a variant of this pair, see GetQuadShader()
+	static const char* s_QuadShaderBase = "GLCore/Renderer2D";
+
+	static const char* s_QuadVertexShaderSource = R"(
+		#version 450 core
+
+		#include "GLCore/Camera.glsl"
+
+		out vec4 v_Color;
+		out vec2 v_TexCoord;
+		flat out float v_TexIndex;
+
+		#ifdef VERTEX_PULLING
+		struct Sprite
+		{
+			vec2 Position;
+			vec2 Size;
+			float Depth;
+			uint Color;
+			uint TexCoordMin;
+			uint TexCoordMax;
+			uint TexIndex;
+			uint Padding;
+		};
+
+		layout (std430, binding = 0) readonly buffer SpriteBuffer
+		{
+			Sprite s_Sprites[];
+		};
+
+		// Two triangles per sprite, same winding as the batched index buffer
+		const vec2 c_Corners[6] = vec2[](
+			vec2(0.0f, 0.0f), vec2(1.0f, 0.0f), vec2(1.0f, 1.0f),
+			vec2(1.0f, 1.0f), vec2(0.0f, 1.0f), vec2(0.0f, 0.0f)
+		);
+
+		void main()
+		{
+			Sprite sprite = s_Sprites[gl_VertexID / 6];
+			vec2 corner = c_Corners[gl_VertexID % 6];
+
+			v_Color = unpackUnorm4x8(sprite.Color);
+			v_TexCoord = mix(unpackUnorm2x16(sprite.TexCoordMin), unpackUnorm2x16(sprite.TexCoordMax), corner);
+			v_TexIndex = float(sprite.TexIndex);
+
+			vec2 position = sprite.Position + (corner - 0.5f) * sprite.Size;
+			gl_Position = u_ViewProjection * vec4(position, sprite.Depth, 1.0f);
+		}
+		#else
+		layout (location = 0) in vec3 a_Position;
+		layout (location = 1) in vec4 a_Color;
+		layout (location = 2) in vec2 a_TexCoord;
+		layout (location = 3) in float a_TexIndex;
+
+		void main()
+		{
+			v_Color = a_Color;
+			v_TexCoord = a_TexCoord;
+			v_TexIndex = a_TexIndex;
+			gl_Position = u_ViewProjection * vec4(a_Position, 1.0f);
+		}
+		#endif
+	)";
+
+	// TEXTURE_ARRAY: one sampler, so no sampler-count limit and no branch over
+	// the slots. Index 0 is white like slot 0, layer N is stored as N + 1.
+	// Neither flag: every quad of the batch uses slot 0 (white), nothing is sampled.
+	static const char* s_QuadFragmentShaderSource = R"(
+		#version 450 core
+
+		layout (location = 0) out vec4 o_Color;
+
+		in vec4 v_Color;
+		in vec2 v_TexCoord;
+		flat in float v_TexIndex;
+
+		#if defined(TEXTURE_ARRAY)
+		layout (binding = 0) uniform sampler2DArray u_TextureArray;
+		#elif defined(TEXTURED)
+		#include "GLCore/TextureSlots.glsl"
+		#endif
+
+		void main()
+		{
+			vec4 texColor = vec4(1.0f);
+		#if defined(TEXTURE_ARRAY)
+			if (v_TexIndex > 0.0f)
+				texColor = texture(u_TextureArray, vec3(v_TexCoord, v_TexIndex - 1.0f));
+		#elif defined(TEXTURED)
+			texColor = SampleTextureSlot(int(v_TexIndex), v_TexCoord);
+		#endif
+			o_Color = texColor * v_Color;
+		}
+	)";
+
+	// The sampler array matches the number of texture units (bound to units
+	// 0..N-1 by the array binding), and is indexed through a switch so every
+	// lookup uses a constant (dynamically uniform) index
+	static std::string GenerateTextureSlotsSource(uint32_t textureSlots)
+	{
+		std::stringstream ss;
+		ss << "#pragma once\n"
+			"\n"
+			"layout (binding = 0) uniform sampler2D u_Textures[" << textureSlots << "];\n"
+			"\n"
+			"vec4 SampleTextureSlot(int index, vec2 texCoord)\n"
+			"{\n"
+			"	switch (index)\n"
+			"	{\n";
+		for (uint32_t i = 0; i < textureSlots; i++)
+			ss << "		case " << i << ": return texture(u_Textures[" << i << "], texCoord);\n";
+		ss << "	}\n"
+			"	return vec4(1.0f);\n"
+			"}\n";
+		return ss.str();
+	}
+
+	static Utils::Shader* GetQuadShader(bool vertexPulling, bool textureArray, bool textured)
+	{
+		uint32_t flags = Utils::ShaderVariantNone;
+		if (vertexPulling)
+			flags |= Utils::ShaderVariantVertexPulling;
+		if (textureArray)
+			flags |= Utils::ShaderVariantTextureArray;
+		else if (textured)
+			flags |= Utils::ShaderVariantTextured;
+		return Utils::Shader::Get(s_QuadShaderBase, flags);
+	}
+
+	void Renderer2D::Init()
+	{
+		uint32_t maxTextureSlots = TextureSlotManager::QueryMaxTextureSlots();
+
+		std::string base = s_QuadShaderBase;
+		Utils::ShaderPreprocessor::AddVirtualFile(base + ".vert.glsl", s_QuadVertexShaderSource);
+		Utils::ShaderPreprocessor::AddVirtualFile(base + ".frag.glsl", s_QuadFragmentShaderSource);
+		Utils::ShaderPreprocessor::AddVirtualFile("GLCore/TextureSlots.glsl", GenerateTextureSlotsSource(maxTextureSlots));
+
+		// Built now, in one batch the driver can compile in parallel, rather than one
+		// by one on the first batch that needs them
+		std::vector<Utils::ShaderVariantRequest> variants;
+		for (uint32_t path : { (uint32_t)Utils::ShaderVariantNone, (uint32_t)Utils::ShaderVariantVertexPulling })
+		{
+			for (uint32_t texturing : { Utils::ShaderVariantNone, Utils::ShaderVariantTextured, Utils::ShaderVariantTextureArray })
+				variants.push_back({ base, path | texturing });
+		}
+		Utils::Shader::WarmupStatistics warmup = Utils::Shader::Warmup(variants);
+		LOG_INFO("Renderer2D: {0} programs ({1} cached) in {2:.1f} ms: preprocess {3:.1f} ms, submit {4:.1f} ms, collect {5:.1f} ms{6}",
+			warmup.Programs, warmup.CacheHits, warmup.TotalMs, warmup.PreprocessMs, warmup.SubmitMs, warmup.CollectMs,
+			warmup.ParallelCompile ? ", parallel compile" : "");
+
+		GLint storageAlignment = 1;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+		s_Data.StorageBufferAlignment = (uint32_t)storageAlignment;
+
+		// Core profile needs a vertex array bound even when nothing is fetched from it
+		glCreateVertexArrays(1, &s_Data.SpriteVA);
+
+		glCreateVertexArrays(1, &s_Data.QuadVA);
+		SetQuadVertexAttributes(s_Data.QuadVA, s_Data.VertexFormat);
+
+		// The vertex buffer is attached to binding 0 at flush time, at the offset the stream buffer returns.
+		// Buffers are sized for the largest vertex format.
+		s_Data.QuadVertexStream = std::make_unique<StreamBuffer>(Renderer2DData::MaxVertices * (uint32_t)sizeof(QuadVertex));
+
+		// The index pattern is the same for every batch, so it is built once
+		std::vector<uint32_t> indices(Renderer2DData::MaxIndices);
+		uint32_t offset = 0; // offset = num iterations * 4
+		for (uint32_t i = 0; i < Renderer2DData::MaxIndices; i += 6)
+		{
+			indices[i + 0] = 0 + offset;
+			indices[i + 1] = 1 + offset;
+			indices[i + 2] = 2 + offset;
+
+			indices[i + 3] = 2 + offset;
+			indices[i + 4] = 3 + offset;
+			indices[i + 5] = 0 + offset;
+
+			offset += 4;
+		}
+
+		glCreateBuffers(1, &s_Data.QuadIB);
+		glNamedBufferData(s_Data.QuadIB, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		glVertexArrayElementBuffer(s_Data.QuadVA, s_Data.QuadIB);
+
+		s_Data.QuadVertexBufferBase = new uint8_t[Renderer2DData::MaxVertices * sizeof(QuadVertex)];
+
+		// 1x1 white texture so untextured quads can share the batch
+		uint32_t whiteTextureData = 0xffffffff;
+		glCreateTextures(GL_TEXTURE_2D, 1, &s_Data.WhiteTexture);
+		glTextureStorage2D(s_Data.WhiteTexture, 1, GL_RGBA8, 1, 1);
+		glTextureSubImage2D(s_Data.WhiteTexture, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &whiteTextureData);
+
+		s_Data.TextureSlots.Init(maxTextureSlots, s_Data.WhiteTexture);
+	}
+
+	void Renderer2D::Shutdown()
+	{
+		delete[] s_Data.QuadVertexBufferBase;
+		s_Data.QuadVertexBufferBase = nullptr;
+
+		glDeleteVertexArrays(1, &s_Data.QuadVA);
+		glDeleteVertexArrays(1, &s_Data.SpriteVA);
+		s_Data.QuadVertexStream.reset();
+		s_Data.BuilderVertexStream.reset();
+		glDeleteBuffers(1, &s_Data.QuadIB);
+		glDeleteTextures(1, &s_Data.WhiteTexture);
+
+		// The names above may be reused
+		GLStateCache::Invalidate();
+	}
+
+	void Renderer2D::BeginScene(const Utils::OrthographicCamera& camera)
+	{
+		// Every variant reads the shared Camera block
+		FrameUniforms::SetCamera(camera);
+
+		StartBatch();
+	}
+
+	void Renderer2D::EndScene()
+	{
+		Flush();
+	}
+
+	void Renderer2D::StartBatch()
+	{
+		s_Data.QuadIndexCount = 0;
+		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+
+		s_Data.TextureSlots.Reset();
+		s_Data.BatchTextureArray = 0;
+	}
+
+	void Renderer2D::NextBatch()
+	{
+		Flush();
+		StartBatch();
+	}
+
+	void Renderer2D::Flush()
+	{
+		if (s_Data.QuadIndexCount == 0)
+			return; // Nothing to draw
+
+		// Only upload the part of the buffer that was written this batch
+		uint32_t dataSize = (uint32_t)(s_Data.QuadVertexBufferPtr - s_Data.QuadVertexBufferBase);
+		s_Data.Stats.UploadedBytes += dataSize;
+
+		// A batch of only untextured quads has nothing but white in slot 0
+		const bool useTextureArray = s_Data.BatchTextureArray != 0;
+		const bool textured = useTextureArray || s_Data.TextureSlots.GetSlotCount() > 1;
+		if (useTextureArray)
+			GLStateCache::BindTextureUnit(0, s_Data.BatchTextureArray);
+		else if (textured)
+			s_Data.TextureSlots.Bind();
+
+		if (s_Data.Path == Renderer2DPath::VertexPulling)
+		{
+			uint32_t offset = s_Data.QuadVertexStream->Upload(s_Data.QuadVertexBufferBase, dataSize, s_Data.StorageBufferAlignment);
+			GLStateCache::BindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, s_Data.QuadVertexStream->GetRendererID(), offset, dataSize);
+
+			GLStateCache::UseProgram(GetQuadShader(true, useTextureArray, textured)->GetRendererID());
+			GLStateCache::BindVertexArray(s_Data.SpriteVA);
+			glDrawArrays(GL_TRIANGLES, 0, s_Data.QuadIndexCount);
+		}
+		else
+		{
+			uint32_t offset = s_Data.QuadVertexStream->Upload(s_Data.QuadVertexBufferBase, dataSize);
+			glVertexArrayVertexBuffer(s_Data.QuadVA, 0, s_Data.QuadVertexStream->GetRendererID(), offset, GetQuadVertexSize(s_Data.VertexFormat));
+
+			GLStateCache::UseProgram(GetQuadShader(false, useTextureArray, textured)->GetRendererID());
+			GLStateCache::BindVertexArray(s_Data.QuadVA);
+			glDrawElements(GL_TRIANGLES, s_Data.QuadIndexCount, GL_UNSIGNED_INT, nullptr);
+		}
+
+		s_Data.QuadVertexStream->Fence();
+		s_Data.Stats.DrawCalls++;
+	}
+
+	void Renderer2D::SetStreamBufferStrategy(StreamBufferStrategy strategy)
+	{
+		if (s_Data.QuadVertexStream->GetStrategy() == strategy)
+			return;
+
+		s_Data.QuadVertexStream = std::make_unique<StreamBuffer>(Renderer2DData::MaxVertices * (uint32_t)sizeof(QuadVertex), strategy);
+	}
+
+	StreamBufferStrategy Renderer2D::GetStreamBufferStrategy()
+	{
+		return s_Data.QuadVertexStream->GetStrategy();
+	}
+
+	void Renderer2D::SetPath(Renderer2DPath path)
+	{
+		if (s_Data.Path == path)
+			return;
+
+		if (s_Data.QuadIndexCount > 0)
+			NextBatch();
+
+		s_Data.Path = path;
+	}
+
+	Renderer2DPath Renderer2D::GetPath()
+	{
+		return s_Data.Path;
+	}
+
+	void Renderer2D::SetVertexFormat(QuadVertexFormat format)
+	{
+		if (s_Data.VertexFormat == format)
+			return;
+
+		// Quads already in the batch were written in the old format
+		if (s_Data.QuadIndexCount > 0)
+			NextBatch();
+
+		s_Data.VertexFormat = format;
+		SetQuadVertexAttributes(s_Data.QuadVA, format);
+	}
+
+	QuadVertexFormat Renderer2D::GetVertexFormat()
+	{
+		return s_Data.VertexFormat;
+	}
+
+	static void SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float textureIndex,
+		const glm::vec2& texCoordMin = { 0.0f, 0.0f }, const glm::vec2& texCoordMax = { 1.0f, 1.0f })
+	{
+		if (s_Data.Path == Renderer2DPath::VertexPulling)
+		{
+			s_Data.QuadVertexBufferPtr = WriteQuadSprite(s_Data.QuadVertexBufferPtr,
+				position, size, color, textureIndex, texCoordMin, texCoordMax);
+		}
+		else
+		{
+			s_Data.QuadVertexBufferPtr = WriteQuadVertices(s_Data.VertexFormat, s_Data.QuadVertexBufferPtr,
+				position, size, color, textureIndex, texCoordMin, texCoordMax);
+		}
+
+		s_Data.QuadIndexCount += 6;
+		s_Data.Stats.QuadCount++;
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, color);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			NextBatch();
+
+		SubmitQuad(position, size, color, 0.0f);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, textureID, tintColor);
+	}
+
+	int32_t Renderer2D::AcquireTextureSlot(GLuint textureID)
+	{
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices || s_Data.BatchTextureArray != 0)
+			NextBatch();
+
+		int32_t textureSlot = s_Data.TextureSlots.Acquire(textureID);
+		if (textureSlot < 0)
+		{
+			// Out of texture units, flush and start over with an empty slot table
+			NextBatch();
+			textureSlot = s_Data.TextureSlots.Acquire(textureID);
+		}
+		return textureSlot;
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor)
+	{
+		int32_t textureSlot = AcquireTextureSlot(textureID);
+		SubmitQuad(position, size, tintColor, (float)textureSlot);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, subTexture, tintColor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor)
+	{
+		int32_t textureSlot = AcquireTextureSlot(subTexture.TextureID);
+		SubmitQuad(position, size, tintColor, (float)textureSlot, subTexture.TexCoordMin, subTexture.TexCoordMax);
+	}
+
+	void Renderer2D::UseTextureArray(GLuint textureArrayID)
+	{
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			NextBatch();
+
+		if (s_Data.BatchTextureArray == textureArrayID)
+			return;
+
+		// A slot batch holding only untextured quads can be taken over as is
+		if (s_Data.BatchTextureArray != 0 || s_Data.TextureSlots.GetSlotCount() > 1)
+			NextBatch();
+		s_Data.BatchTextureArray = textureArrayID;
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const TextureLayer& textureLayer, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, textureLayer, tintColor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const TextureLayer& textureLayer, const glm::vec4& tintColor)
+	{
+		UseTextureArray(textureLayer.TextureArrayID);
+		SubmitQuad(position, size, tintColor, (float)(textureLayer.Layer + 1));
+	}
+
+	void Renderer2D::DrawQuads(const QuadKernelInput& input, GLuint textureID)
+	{
+		if (input.Count == 0)
+			return;
+
+		// The kernel writes Standard vertices only
+		Renderer2DPath previousPath = s_Data.Path;
+		QuadVertexFormat previousFormat = s_Data.VertexFormat;
+		SetPath(Renderer2DPath::VertexBatch);
+		SetVertexFormat(QuadVertexFormat::Standard);
+
+		int32_t textureSlot = textureID ? AcquireTextureSlot(textureID) : 0;
+
+		uint32_t submitted = 0;
+		while (submitted < input.Count)
+		{
+			uint32_t capacity = (Renderer2DData::MaxIndices - s_Data.QuadIndexCount) / 6;
+			if (capacity == 0)
+			{
+				NextBatch();
+				if (textureID)
+					textureSlot = s_Data.TextureSlots.Acquire(textureID);
+				continue;
+			}
+
+			uint32_t count = std::min(capacity, input.Count - submitted);
+			QuadKernelInput chunk = input.Slice(submitted, count);
+			chunk.TexIndex = nullptr; // texture slots are the renderer's business
+			chunk.ConstantTexIndex = (float)textureSlot;
+
+			GenerateQuadVertices(chunk, (QuadVertex*)s_Data.QuadVertexBufferPtr);
+			s_Data.QuadVertexBufferPtr += count * 4 * sizeof(QuadVertex);
+			s_Data.QuadIndexCount += count * 6;
+			s_Data.Stats.QuadCount += count;
+			submitted += count;
+		}
+
+		SetPath(previousPath);
+		SetVertexFormat(previousFormat);
+	}
+
+	// Grows with the largest arena seen and follows the quad stream's strategy
+	static StreamBuffer& GetBuilderVertexStream(uint32_t arenaSize)
+	{
+		StreamBufferStrategy strategy = s_Data.QuadVertexStream->GetStrategy();
+		std::unique_ptr<StreamBuffer>& stream = s_Data.BuilderVertexStream;
+		if (!stream || stream->GetMaxUploadSize() < arenaSize || stream->GetStrategy() != strategy)
+			stream = std::make_unique<StreamBuffer>(arenaSize, strategy);
+		return *stream;
+	}
+
+	void Renderer2D::DrawQuads(const ParallelQuadBuilder& builder, const GLuint* textureIDs, uint32_t textureCount)
+	{
+		if (builder.GetQuadCount() == 0)
+			return;
+
+		// Chunks are handed out from the front of the arena, so that prefix is all there is to upload
+		uint32_t size = builder.GetUsedChunkCount() * builder.GetChunkQuads() * 4 * (uint32_t)sizeof(QuadVertex);
+		StreamBuffer& stream = GetBuilderVertexStream(builder.GetArenaSize());
+		uint32_t offset = stream.Upload(builder.GetVertices(), size, 64);
+		s_Data.Stats.UploadedBytes += size;
+
+		DrawBuilderChunks(builder, stream.GetRendererID(), offset, textureIDs, textureCount);
+		stream.Fence();
+	}
+
+	void Renderer2D::BuildQuads(ParallelQuadBuilder& builder, uint32_t taskCount, const ParallelQuadBuilder::TaskFn& task,
+		const GLuint* textureIDs, uint32_t textureCount)
+	{
+		// Cache line aligned like the builder's own arena, so workers never share a line
+		uint32_t offset;
+		StreamBuffer& stream = GetBuilderVertexStream(builder.GetArenaSize());
+		QuadVertex* target = (QuadVertex*)stream.Map(builder.GetArenaSize(), offset, 64);
+		builder.Build(taskCount, task, target);
+		stream.Unmap();
+
+		if (builder.GetQuadCount() == 0)
+			return;
+
+		s_Data.Stats.UploadedBytes += builder.GetQuadCount() * 4 * (uint32_t)sizeof(QuadVertex);
+		DrawBuilderChunks(builder, stream.GetRendererID(), offset, textureIDs, textureCount);
+		stream.Fence();
+	}
+
+	void Renderer2D::DrawBuilderChunks(const ParallelQuadBuilder& builder, GLuint vertexBuffer, uint32_t offset, const GLuint* textureIDs, uint32_t textureCount)
+	{
+		GLCORE_ASSERT(textureCount < s_Data.TextureSlots.GetMaxSlots(), "Too many textures for a single batch!");
+		GLCORE_ASSERT(builder.GetChunkQuads() <= Renderer2DData::MaxQuads, "Builder chunks are larger than the index buffer!");
+
+		// Quads submitted earlier stay underneath. Builder texture indices are
+		// fixed, so the draw gets a slot table of its own.
+		NextBatch();
+		for (uint32_t i = 0; i < textureCount; i++)
+		{
+			int32_t textureSlot = s_Data.TextureSlots.Acquire(textureIDs[i]);
+			GLCORE_ASSERT(textureSlot == (int32_t)i + 1, "Texture IDs must be distinct!");
+		}
+		s_Data.TextureSlots.Bind();
+
+		// Every chunk starts at quad 0 of the shared index pattern, moved to the chunk's arena position
+		const std::vector<QuadChunk>& chunks = builder.GetChunks();
+		s_Data.ChunkIndexCounts.clear();
+		s_Data.ChunkIndexOffsets.clear();
+		s_Data.ChunkBaseVertices.clear();
+		for (const QuadChunk& chunk : chunks)
+		{
+			s_Data.ChunkIndexCounts.push_back((GLsizei)chunk.QuadCount * 6);
+			s_Data.ChunkIndexOffsets.push_back(nullptr);
+			s_Data.ChunkBaseVertices.push_back((GLint)(chunk.Index * builder.GetChunkQuads() * 4));
+		}
+
+		// Builder vertices are always Standard
+		if (s_Data.VertexFormat != QuadVertexFormat::Standard)
+			SetQuadVertexAttributes(s_Data.QuadVA, QuadVertexFormat::Standard);
+		glVertexArrayVertexBuffer(s_Data.QuadVA, 0, vertexBuffer, offset, sizeof(QuadVertex));
+
+		GLStateCache::UseProgram(GetQuadShader(false, false, textureCount > 0)->GetRendererID());
+		GLStateCache::BindVertexArray(s_Data.QuadVA);
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, s_Data.ChunkIndexCounts.data(), GL_UNSIGNED_INT,
+			s_Data.ChunkIndexOffsets.data(), (GLsizei)chunks.size(), s_Data.ChunkBaseVertices.data());
+
+		if (s_Data.VertexFormat != QuadVertexFormat::Standard)
+			SetQuadVertexAttributes(s_Data.QuadVA, s_Data.VertexFormat);
+
+		s_Data.Stats.DrawCalls++;
+		s_Data.Stats.QuadCount += builder.GetQuadCount();
+
+		// Later quads must not inherit the fixed slot table
+		StartBatch();
+	}
+
+	void Renderer2D::DrawStaticBatch(StaticQuadBatch& batch)
+	{
+		NextBatch();
+
+		// Static chunks are always Standard vertices
+		if (s_Data.VertexFormat != QuadVertexFormat::Standard)
+			SetQuadVertexAttributes(s_Data.QuadVA, QuadVertexFormat::Standard);
+
+		GLStateCache::UseProgram(GetQuadShader(false, false, true)->GetRendererID());
+		GLStateCache::BindVertexArray(s_Data.QuadVA);
+		GLStateCache::BindTextureUnit(0, s_Data.WhiteTexture);
+
+		for (StaticQuadBatch::Chunk& chunk : batch.m_Chunks)
+		{
+			if (chunk.Dirty)
+			{
+				s_Data.Stats.UploadedBytes += batch.Rebuild(chunk);
+				s_Data.Stats.StaticChunkRebuilds++;
+			}
+
+			if (chunk.BuiltQuadCount == 0)
+				continue;
+
+			if (chunk.Textures.size() > 1)
+				GLStateCache::BindTextures(1, (GLsizei)chunk.Textures.size() - 1, chunk.Textures.data() + 1);
+
+			glVertexArrayVertexBuffer(s_Data.QuadVA, 0, chunk.VertexBuffer, 0, sizeof(QuadVertex));
+			glDrawElements(GL_TRIANGLES, chunk.BuiltQuadCount * 6, GL_UNSIGNED_INT, nullptr);
+
+			s_Data.Stats.DrawCalls++;
+			s_Data.Stats.QuadCount += chunk.BuiltQuadCount;
+		}
+
+		if (s_Data.VertexFormat != QuadVertexFormat::Standard)
+			SetQuadVertexAttributes(s_Data.QuadVA, s_Data.VertexFormat);
+	}
+
+	uint32_t Renderer2D::GetMaxTextureSlots()
+	{
+		return s_Data.TextureSlots.GetMaxSlots();
+	}
+
+	uint32_t Renderer2D::GetMaxQuadsPerBatch()
+	{
+		return Renderer2DData::MaxQuads;
+	}
+
+	const Renderer2D::Statistics& Renderer2D::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+	void Renderer2D::ResetStats()
+	{
+		s_Data.Stats = Statistics();
+	}
+
+}
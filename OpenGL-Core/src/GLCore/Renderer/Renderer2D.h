@@ -0,0 +1,109 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "StreamBuffer.h"
+#include "QuadVertex.h"
+#include "QuadKernel.h"
+#include "ParallelQuadBuilder.h"
+#include "StaticQuadBatch.h"
+#include "SubTexture.h"
+
+#include "GLCore/Util/OrthographicCamera.h"
+
+namespace GLCore {
+
+	enum class Renderer2DPath
+	{
+		VertexBatch = 0, // four vertices per quad plus a shared index buffer
+		VertexPulling    // one QuadSprite per quad in an SSBO, corners expanded from gl_VertexID
+	};
+
+	// Batched quad renderer. Quads submitted between BeginScene and EndScene are
+	// written into a CPU-side vertex buffer and drawn with as few draw calls as
+	// possible; the batch is flushed automatically when it runs out of vertices
+	// or texture slots.
+	//
+	// A batch samples either individual textures through the texture slots or
+	// the layers of one texture array (TextureLayer quads). Untextured quads fit
+	// in both; switching between the two, or to another array, starts a new batch.
+	class Renderer2D
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static void BeginScene(const Utils::OrthographicCamera& camera);
+		static void EndScene();
+		static void Flush();
+
+		// How batched vertices are streamed to the GPU; the best choice depends on the driver
+		static void SetStreamBufferStrategy(StreamBufferStrategy strategy);
+		static StreamBufferStrategy GetStreamBufferStrategy();
+
+		// Both paths take the same Draw* calls, so they can be switched at runtime for A/B comparisons
+		static void SetPath(Renderer2DPath path);
+		static Renderer2DPath GetPath();
+
+		// Vertex layout used by the VertexBatch path; the compact formats trade precision for upload bandwidth
+		static void SetVertexFormat(QuadVertexFormat format);
+		static QuadVertexFormat GetVertexFormat();
+
+		// Texture units available to a single batch (GL_MAX_TEXTURE_IMAGE_UNITS)
+		static uint32_t GetMaxTextureSlots();
+		static uint32_t GetMaxQuadsPerBatch();
+
+		// Primitives (position is the center of the quad)
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const TextureLayer& textureLayer, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const TextureLayer& textureLayer, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		// Bulk submission of rotated/scaled sprites from structure-of-arrays data, all
+		// sampling one texture (0 = white). Vertices are generated by the SIMD quad
+		// kernel straight into the batch; the batch switches to the Standard
+		// VertexBatch layout for the duration of the call if needed.
+		static void DrawQuads(const QuadKernelInput& input, GLuint textureID = 0);
+
+		// Draws the result of a ParallelQuadBuilder::Build in the builder's chunk order,
+		// in one draw call, after uploading the written part of its arena as is.
+		// A vertex texture index of N > 0 samples textureIDs[N - 1] (which must be
+		// distinct), 0 samples white.
+		static void DrawQuads(const ParallelQuadBuilder& builder, const GLuint* textureIDs = nullptr, uint32_t textureCount = 0);
+		// Same, but runs builder.Build(taskCount, task) with its arena mapped from a
+		// stream buffer, so the workers write GL memory and nothing is copied. The
+		// stream keeps StreamBuffer::RegionCount arenas in flight.
+		static void BuildQuads(ParallelQuadBuilder& builder, uint32_t taskCount, const ParallelQuadBuilder::TaskFn& task,
+			const GLuint* textureIDs = nullptr, uint32_t textureCount = 0);
+
+		// Draws retained quads one chunk per draw call straight from their own
+		// buffers, rebuilding only chunks that changed. Quads submitted earlier
+		// in the scene are flushed first so they stay underneath.
+		static void DrawStaticBatch(StaticQuadBatch& batch);
+
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t QuadCount = 0;
+			uint32_t UploadedBytes = 0;
+			uint32_t StaticChunkRebuilds = 0;
+
+			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
+			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
+		};
+		static const Statistics& GetStats();
+		static void ResetStats();
+	private:
+		static void StartBatch();
+		static void NextBatch();
+		static int32_t AcquireTextureSlot(GLuint textureID);
+		static void UseTextureArray(GLuint textureArrayID);
+		static void DrawBuilderChunks(const ParallelQuadBuilder& builder, GLuint vertexBuffer, uint32_t offset, const GLuint* textureIDs, uint32_t textureCount);
+	};
+
+}
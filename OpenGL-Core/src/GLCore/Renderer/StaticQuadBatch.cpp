@@ -0,0 +1,195 @@
+#include "glpch.h"
+#include "StaticQuadBatch.h"
+
+#include "Renderer2D.h"
+#include "QuadVertex.h"
+
+namespace GLCore {
+
+	StaticQuadBatch::StaticQuadBatch(uint32_t chunkQuads)
+		: m_ChunkQuads(std::min(std::max(chunkQuads, 1u), Renderer2D::GetMaxQuadsPerBatch()))
+	{
+		// Slot 0 is the white texture
+		m_MaxChunkTextures = Renderer2D::GetMaxTextureSlots() - 1;
+	}
+
+	StaticQuadBatch::~StaticQuadBatch()
+	{
+		Clear();
+	}
+
+	uint32_t StaticQuadBatch::AllocateHandle()
+	{
+		if (m_FreeHandle != InvalidHandle)
+		{
+			uint32_t handle = m_FreeHandle;
+			m_FreeHandle = m_Locations[handle].Index;
+			return handle;
+		}
+
+		m_Locations.push_back({ 0, 0 });
+		return (uint32_t)m_Locations.size() - 1;
+	}
+
+	bool StaticQuadBatch::Fits(const Chunk& chunk, GLuint textureID) const
+	{
+		if (chunk.Quads.size() >= m_ChunkQuads)
+			return false;
+
+		return textureID == 0 || chunk.TextureRefCounts.find(textureID) != chunk.TextureRefCounts.end()
+			|| chunk.TextureRefCounts.size() < m_MaxChunkTextures;
+	}
+
+	void StaticQuadBatch::Place(uint32_t handle, const StaticQuad& quad)
+	{
+		// Newest chunk first, that is where free space usually is
+		uint32_t chunkIndex = (uint32_t)m_Chunks.size();
+		for (uint32_t i = (uint32_t)m_Chunks.size(); i-- > 0; )
+		{
+			if (Fits(m_Chunks[i], quad.TextureID))
+			{
+				chunkIndex = i;
+				break;
+			}
+		}
+		if (chunkIndex == m_Chunks.size())
+			m_Chunks.emplace_back();
+
+		Chunk& chunk = m_Chunks[chunkIndex];
+		m_Locations[handle] = { chunkIndex, (uint32_t)chunk.Quads.size() };
+		chunk.Quads.push_back(quad);
+		chunk.Handles.push_back(handle);
+		if (quad.TextureID)
+			chunk.TextureRefCounts[quad.TextureID]++;
+		chunk.Dirty = true;
+	}
+
+	void StaticQuadBatch::Unplace(uint32_t handle)
+	{
+		Location location = m_Locations[handle];
+		Chunk& chunk = m_Chunks[location.Chunk];
+
+		GLuint textureID = chunk.Quads[location.Index].TextureID;
+		if (textureID && --chunk.TextureRefCounts[textureID] == 0)
+			chunk.TextureRefCounts.erase(textureID);
+
+		// Swap with the chunk's last quad so the chunk stays packed
+		uint32_t last = (uint32_t)chunk.Quads.size() - 1;
+		chunk.Quads[location.Index] = chunk.Quads[last];
+		chunk.Handles[location.Index] = chunk.Handles[last];
+		m_Locations[chunk.Handles[location.Index]].Index = location.Index;
+		chunk.Quads.pop_back();
+		chunk.Handles.pop_back();
+		chunk.Dirty = true;
+	}
+
+	uint32_t StaticQuadBatch::Add(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		return Add(position, size, SubTexture{ 0, { 0.0f, 0.0f }, { 1.0f, 1.0f } }, color);
+	}
+
+	uint32_t StaticQuadBatch::Add(const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor)
+	{
+		return Add(position, size, SubTexture{ textureID, { 0.0f, 0.0f }, { 1.0f, 1.0f } }, tintColor);
+	}
+
+	uint32_t StaticQuadBatch::Add(const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor)
+	{
+		uint32_t handle = AllocateHandle();
+		Place(handle, { position, size, tintColor, subTexture.TextureID, subTexture.TexCoordMin, subTexture.TexCoordMax });
+		m_QuadCount++;
+		return handle;
+	}
+
+	void StaticQuadBatch::Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		Set(handle, position, size, SubTexture{ 0, { 0.0f, 0.0f }, { 1.0f, 1.0f } }, color);
+	}
+
+	void StaticQuadBatch::Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor)
+	{
+		Set(handle, position, size, SubTexture{ textureID, { 0.0f, 0.0f }, { 1.0f, 1.0f } }, tintColor);
+	}
+
+	void StaticQuadBatch::Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor)
+	{
+		StaticQuad quad = { position, size, tintColor, subTexture.TextureID, subTexture.TexCoordMin, subTexture.TexCoordMax };
+
+		Location location = m_Locations[handle];
+		Chunk& chunk = m_Chunks[location.Chunk];
+		GLuint previousTexture = chunk.Quads[location.Index].TextureID;
+
+		// Update in place unless the new texture does not fit the chunk's texture list
+		bool textureFits = quad.TextureID == 0 || quad.TextureID == previousTexture
+			|| chunk.TextureRefCounts.find(quad.TextureID) != chunk.TextureRefCounts.end()
+			|| chunk.TextureRefCounts.size() < m_MaxChunkTextures;
+		if (!textureFits)
+		{
+			Unplace(handle);
+			Place(handle, quad);
+			return;
+		}
+
+		if (previousTexture && --chunk.TextureRefCounts[previousTexture] == 0)
+			chunk.TextureRefCounts.erase(previousTexture);
+		if (quad.TextureID)
+			chunk.TextureRefCounts[quad.TextureID]++;
+
+		chunk.Quads[location.Index] = quad;
+		chunk.Dirty = true;
+	}
+
+	void StaticQuadBatch::Remove(uint32_t handle)
+	{
+		Unplace(handle);
+		m_Locations[handle].Index = m_FreeHandle;
+		m_FreeHandle = handle;
+		m_QuadCount--;
+	}
+
+	void StaticQuadBatch::Clear()
+	{
+		for (Chunk& chunk : m_Chunks)
+			glDeleteBuffers(1, &chunk.VertexBuffer);
+
+		m_Chunks.clear();
+		m_Locations.clear();
+		m_FreeHandle = InvalidHandle;
+		m_QuadCount = 0;
+	}
+
+	uint32_t StaticQuadBatch::Rebuild(Chunk& chunk)
+	{
+		chunk.Textures.assign(1, 0);
+		std::unordered_map<GLuint, uint32_t> slots;
+		for (const auto& [textureID, refCount] : chunk.TextureRefCounts)
+		{
+			slots[textureID] = (uint32_t)chunk.Textures.size();
+			chunk.Textures.push_back(textureID);
+		}
+
+		std::vector<QuadVertex> vertices(chunk.Quads.size() * 4);
+		uint8_t* target = (uint8_t*)vertices.data();
+		for (const StaticQuad& quad : chunk.Quads)
+		{
+			float textureIndex = quad.TextureID ? (float)slots[quad.TextureID] : 0.0f;
+			target = WriteQuadVertices(QuadVertexFormat::Standard, target, quad.Position, quad.Size, quad.Color,
+				textureIndex, quad.TexCoordMin, quad.TexCoordMax);
+		}
+
+		// Immutable storage cannot be respecified, so a rebuild means a new buffer
+		glDeleteBuffers(1, &chunk.VertexBuffer);
+		chunk.VertexBuffer = 0;
+		chunk.BuiltQuadCount = (uint32_t)chunk.Quads.size();
+		chunk.Dirty = false;
+
+		uint32_t size = (uint32_t)(vertices.size() * sizeof(QuadVertex));
+		if (size == 0)
+			return 0;
+
+		glCreateBuffers(1, &chunk.VertexBuffer);
+		glNamedBufferStorage(chunk.VertexBuffer, size, vertices.data(), 0);
+		return size;
+	}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "SubTexture.h"
+
+#include <unordered_map>
+
+namespace GLCore {
+
+	// Retained quads for content that rarely changes (level tiles, backgrounds).
+	// Quads are grouped into chunks, each with its own immutable vertex buffer
+	// (glNamedBufferStorage without GL_DYNAMIC_STORAGE_BIT) and texture list.
+	// A chunk is only rebuilt, i.e. its buffer recreated, when one of its quads
+	// was added, changed or removed; drawing an unchanged chunk uploads nothing.
+	// Draw with Renderer2D::DrawStaticBatch.
+	class StaticQuadBatch
+	{
+	public:
+		static const uint32_t InvalidHandle = 0xffffffff;
+
+		// chunkQuads is clamped to the Renderer2D batch size
+		StaticQuadBatch(uint32_t chunkQuads = 4096);
+		~StaticQuadBatch();
+
+		StaticQuadBatch(const StaticQuadBatch&) = delete;
+		StaticQuadBatch& operator=(const StaticQuadBatch&) = delete;
+
+		// Position is the center of the quad; textureID 0 means untextured
+		uint32_t Add(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		uint32_t Add(const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor = glm::vec4(1.0f));
+		uint32_t Add(const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		// Replaces a quad, keeping its handle
+		void Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		void Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, GLuint textureID, const glm::vec4& tintColor = glm::vec4(1.0f));
+		void Set(uint32_t handle, const glm::vec3& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		void Remove(uint32_t handle);
+		void Clear();
+
+		uint32_t GetQuadCount() const { return m_QuadCount; }
+		uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+	private:
+		struct StaticQuad
+		{
+			glm::vec3 Position;
+			glm::vec2 Size;
+			glm::vec4 Color;
+			GLuint TextureID;
+			glm::vec2 TexCoordMin, TexCoordMax;
+		};
+
+		struct Chunk
+		{
+			std::vector<StaticQuad> Quads;
+			std::vector<uint32_t> Handles;                       // parallel to Quads
+			std::unordered_map<GLuint, uint32_t> TextureRefCounts; // textured quads per texture
+
+			// Built state
+			GLuint VertexBuffer = 0;
+			std::vector<GLuint> Textures; // slot n samples Textures[n], slot 0 is white
+			uint32_t BuiltQuadCount = 0;
+			bool Dirty = true;
+		};
+
+		struct Location
+		{
+			uint32_t Chunk;
+			uint32_t Index; // next free handle while unused
+		};
+
+		uint32_t AllocateHandle();
+		void Place(uint32_t handle, const StaticQuad& quad);
+		void Unplace(uint32_t handle);
+		bool Fits(const Chunk& chunk, GLuint textureID) const;
+
+		// Recreates the chunk's immutable buffer, returns the bytes uploaded
+		uint32_t Rebuild(Chunk& chunk);
+	private:
+		uint32_t m_ChunkQuads;
+		uint32_t m_MaxChunkTextures;
+
+		std::vector<Chunk> m_Chunks;
+		std::vector<Location> m_Locations;
+		uint32_t m_FreeHandle = InvalidHandle;
+		uint32_t m_QuadCount = 0;
+
+		friend class Renderer2D;
+	};
+
+}
@@ -0,0 +1,187 @@
+#include "glpch.h"
+#include "StreamBuffer.h"
+
+namespace GLCore {
+
+	StreamBuffer::StreamBuffer(uint32_t maxUploadSize, StreamBufferStrategy strategy)
+		: m_Strategy(strategy), m_MaxUploadSize(maxUploadSize)
+	{
+		if (!IsSupported(m_Strategy))
+		{
+			LOG_WARN("Stream buffer strategy '{0}' is not supported, falling back to '{1}'",
+				GetStrategyName(m_Strategy), GetStrategyName(StreamBufferStrategy::UnsynchronizedMap));
+			m_Strategy = StreamBufferStrategy::UnsynchronizedMap;
+		}
+
+		glCreateBuffers(1, &m_RendererID);
+
+		switch (m_Strategy)
+		{
+		case StreamBufferStrategy::BufferSubData:
+			m_Capacity = m_MaxUploadSize;
+			glNamedBufferData(m_RendererID, m_Capacity, nullptr, GL_DYNAMIC_DRAW);
+			break;
+		case StreamBufferStrategy::Orphan:
+			m_Capacity = m_MaxUploadSize;
+			glNamedBufferData(m_RendererID, m_Capacity, nullptr, GL_STREAM_DRAW);
+			break;
+		case StreamBufferStrategy::UnsynchronizedMap:
+			m_Capacity = m_MaxUploadSize * RegionCount;
+			glNamedBufferData(m_RendererID, m_Capacity, nullptr, GL_STREAM_DRAW);
+			break;
+		case StreamBufferStrategy::PersistentMapped:
+		{
+			m_Capacity = m_MaxUploadSize * RegionCount;
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glNamedBufferStorage(m_RendererID, m_Capacity, nullptr, flags);
+			m_MappedBase = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, m_Capacity, flags);
+			break;
+		}
+		}
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		for (auto& fence : m_Fences)
+			glDeleteSync(fence.Sync);
+
+		if (m_MappedBase)
+			glUnmapNamedBuffer(m_RendererID);
+
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	uint32_t StreamBuffer::Upload(const void* data, uint32_t size, uint32_t alignment)
+	{
+		GLCORE_ASSERT(size <= m_MaxUploadSize, "Upload is larger than the stream buffer region!");
+
+		switch (m_Strategy)
+		{
+		case StreamBufferStrategy::BufferSubData:
+			glNamedBufferSubData(m_RendererID, 0, size, data);
+			return 0;
+		case StreamBufferStrategy::Orphan:
+			glNamedBufferData(m_RendererID, m_Capacity, nullptr, GL_STREAM_DRAW);
+			glNamedBufferSubData(m_RendererID, 0, size, data);
+			return 0;
+		default:
+			break;
+		}
+
+		uint32_t offset;
+		void* target = Map(size, offset, alignment);
+		memcpy(target, data, size);
+		Unmap();
+		return offset;
+	}
+
+	void* StreamBuffer::Map(uint32_t size, uint32_t& offset, uint32_t alignment)
+	{
+		GLCORE_ASSERT(size <= m_MaxUploadSize, "Mapping is larger than the stream buffer region!");
+
+		switch (m_Strategy)
+		{
+		case StreamBufferStrategy::BufferSubData:
+			offset = 0;
+			return glMapNamedBufferRange(m_RendererID, 0, size, GL_MAP_WRITE_BIT);
+		case StreamBufferStrategy::Orphan:
+			offset = 0;
+			return glMapNamedBufferRange(m_RendererID, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		default:
+			break;
+		}
+
+		// Ring strategies: wrap instead of splitting a region across the end of the buffer
+		offset = (m_Cursor + alignment - 1) & ~(alignment - 1);
+		if (offset + size > m_Capacity)
+		{
+			if (m_FencedCursor != m_Cursor)
+				Fence();
+			m_Cursor = 0;
+			m_FencedCursor = 0;
+			offset = 0;
+		}
+
+		WaitForRange(offset, offset + size);
+		m_Cursor = offset + size;
+
+		if (m_Strategy == StreamBufferStrategy::PersistentMapped)
+			return m_MappedBase + offset;
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+		return glMapNamedBufferRange(m_RendererID, offset, size, flags);
+	}
+
+	void StreamBuffer::Unmap()
+	{
+		// The persistent mapping stays valid, coherent writes need no flush
+		if (m_Strategy != StreamBufferStrategy::PersistentMapped)
+			glUnmapNamedBuffer(m_RendererID);
+	}
+
+	void StreamBuffer::Fence()
+	{
+		if (m_Strategy == StreamBufferStrategy::BufferSubData || m_Strategy == StreamBufferStrategy::Orphan)
+			return;
+
+		if (m_FencedCursor == m_Cursor)
+			return; // Nothing uploaded since the last fence
+
+		GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_Fences.push_back({ sync, m_FencedCursor, m_Cursor });
+		m_FencedCursor = m_Cursor;
+	}
+
+	void StreamBuffer::WaitForRange(uint32_t begin, uint32_t end)
+	{
+		// Fences signal in submission order, so waiting on the newest fence that
+		// overlaps the range also retires every fence queued before it
+		int32_t last = -1;
+		for (int32_t i = 0; i < (int32_t)m_Fences.size(); i++)
+		{
+			if (begin < m_Fences[i].End && m_Fences[i].Begin < end)
+				last = i;
+		}
+
+		if (last < 0)
+			return;
+
+		GLsync sync = m_Fences[last].Sync;
+		GLenum result = glClientWaitSync(sync, 0, 0);
+		while (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+		{
+			if (result == GL_WAIT_FAILED)
+			{
+				LOG_ERROR("glClientWaitSync failed while waiting on a stream buffer region");
+				break;
+			}
+			result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+		}
+
+		for (int32_t i = 0; i <= last; i++)
+		{
+			glDeleteSync(m_Fences.front().Sync);
+			m_Fences.pop_front();
+		}
+	}
+
+	bool StreamBuffer::IsSupported(StreamBufferStrategy strategy)
+	{
+		if (strategy == StreamBufferStrategy::PersistentMapped)
+			return GLAD_GL_VERSION_4_4;
+		return true;
+	}
+
+	const char* StreamBuffer::GetStrategyName(StreamBufferStrategy strategy)
+	{
+		switch (strategy)
+		{
+		case StreamBufferStrategy::BufferSubData:     return "BufferSubData";
+		case StreamBufferStrategy::Orphan:            return "Orphan";
+		case StreamBufferStrategy::UnsynchronizedMap: return "UnsynchronizedMap";
+		case StreamBufferStrategy::PersistentMapped:  return "PersistentMapped";
+		}
+		return "Unknown";
+	}
+
+}
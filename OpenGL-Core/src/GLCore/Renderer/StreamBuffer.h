@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <deque>
+
+namespace GLCore {
+
+	enum class StreamBufferStrategy
+	{
+		BufferSubData = 0,  // glNamedBufferSubData into one GL_DYNAMIC_DRAW buffer (driver syncs implicitly)
+		Orphan,             // re-specify the store before every upload so the driver can hand out fresh memory
+		UnsynchronizedMap,  // ring of fenced regions written through GL_MAP_UNSYNCHRONIZED_BIT maps
+		PersistentMapped    // ring of fenced regions in immutable storage mapped once with GL_MAP_PERSISTENT_BIT
+	};
+
+	// Streams per-frame vertex data to the GPU. The ring based strategies keep
+	// RegionCount batches in flight and only wait on the fence of the region
+	// being overwritten, so the CPU never writes memory the GPU is still reading.
+	class StreamBuffer
+	{
+	public:
+		static const uint32_t RegionCount = 3;
+
+		StreamBuffer(uint32_t maxUploadSize, StreamBufferStrategy strategy = StreamBufferStrategy::PersistentMapped);
+		~StreamBuffer();
+
+		StreamBuffer(const StreamBuffer&) = delete;
+		StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+		// Copies size bytes into the buffer and returns the byte offset to source them from.
+		// alignment must be a power of two (e.g. GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT)
+		uint32_t Upload(const void* data, uint32_t size, uint32_t alignment = 1);
+		// Reserves size bytes like Upload but hands out the memory to write them to, so data
+		// can be produced in place (from any thread) instead of copied in. offset receives
+		// the byte offset to source them from; call Unmap() before drawing from it.
+		void* Map(uint32_t size, uint32_t& offset, uint32_t alignment = 1);
+		void Unmap();
+		// Call after issuing the draw(s) that read the data uploaded since the last fence
+		void Fence();
+
+		GLuint GetRendererID() const { return m_RendererID; }
+		uint32_t GetMaxUploadSize() const { return m_MaxUploadSize; }
+		StreamBufferStrategy GetStrategy() const { return m_Strategy; }
+
+		static bool IsSupported(StreamBufferStrategy strategy);
+		static const char* GetStrategyName(StreamBufferStrategy strategy);
+	private:
+		void WaitForRange(uint32_t begin, uint32_t end);
+	private:
+		struct RangeFence
+		{
+			GLsync Sync;
+			uint32_t Begin, End;
+		};
+
+		GLuint m_RendererID = 0;
+		StreamBufferStrategy m_Strategy;
+		uint32_t m_MaxUploadSize;
+		uint32_t m_Capacity;
+
+		uint8_t* m_MappedBase = nullptr;
+		uint32_t m_Cursor = 0;
+		uint32_t m_FencedCursor = 0;
+		std::deque<RangeFence> m_Fences;
+	};
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace GLCore {
+
+	// A rectangle of a texture, e.g. one sprite inside an atlas page
+	struct SubTexture
+	{
+		GLuint TextureID = 0;
+		glm::vec2 TexCoordMin = { 0.0f, 0.0f };
+		glm::vec2 TexCoordMax = { 1.0f, 1.0f };
+	};
+
+	// One layer of a GL_TEXTURE_2D_ARRAY, e.g. one tile of a sheet loaded with Utils::LoadTextureArrayFromSheet
+	struct TextureLayer
+	{
+		GLuint TextureArrayID = 0;
+		uint32_t Layer = 0;
+	};
+
+}
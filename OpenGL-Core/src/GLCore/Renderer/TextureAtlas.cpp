@@ -0,0 +1,130 @@
+#include "glpch.h"
+#include "TextureAtlas.h"
+
+namespace GLCore {
+
+	TextureAtlas::TextureAtlas(const TextureAtlasSpecification& spec)
+		: m_Specification(spec)
+	{
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		ReleasePages();
+	}
+
+	uint32_t TextureAtlas::Add(Utils::Image image)
+	{
+		GLCORE_ASSERT(image.Channels == 4, "TextureAtlas expects RGBA images!");
+
+		m_Images.push_back(std::move(image));
+		m_SubTextures.emplace_back();
+		return (uint32_t)m_SubTextures.size() - 1;
+	}
+
+	uint32_t TextureAtlas::Add(const std::string& path)
+	{
+		return Add(Utils::Image::FromFile(path, 4));
+	}
+
+	bool TextureAtlas::Build()
+	{
+		GLCORE_ASSERT(m_Images.size() == m_SubTextures.size(), "TextureAtlas has already been built!");
+		ReleasePages();
+
+		std::vector<Utils::PackRect> rects(m_Images.size());
+		for (size_t i = 0; i < m_Images.size(); i++)
+		{
+			rects[i].Width = m_Images[i].Width;
+			rects[i].Height = m_Images[i].Height;
+		}
+
+		Utils::TexturePacker packer(m_Specification.Packer);
+		bool packed = packer.Pack(rects);
+		m_Stats = packer.GetStats();
+
+		const uint32_t pageWidth = m_Specification.Packer.PageWidth;
+		const uint32_t pageHeight = m_Specification.Packer.PageHeight;
+
+		uint32_t levels = 1;
+		if (m_Specification.GenerateMips)
+		{
+			while ((std::max(pageWidth, pageHeight) >> levels) > 0)
+				levels++;
+		}
+
+		std::vector<uint8_t> pixels;
+		for (uint32_t page = 0; page < m_Stats.PageCount; page++)
+		{
+			pixels.assign((size_t)pageWidth * pageHeight * 4, 0);
+			for (size_t i = 0; i < rects.size(); i++)
+			{
+				if (rects[i].Page == page)
+					BlitImage(pixels, m_Images[i], rects[i]);
+			}
+
+			GLuint texture;
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTextureStorage2D(texture, levels, GL_RGBA8, pageWidth, pageHeight);
+			glTextureSubImage2D(texture, 0, 0, 0, pageWidth, pageHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			if (levels > 1)
+				glGenerateTextureMipmap(texture);
+
+			m_Pages.push_back(texture);
+		}
+
+		for (size_t i = 0; i < rects.size(); i++)
+		{
+			const Utils::PackRect& rect = rects[i];
+			if (rect.Page == Utils::PackRect::InvalidPage)
+			{
+				LOG_WARN("TextureAtlas: {0}x{1} image did not fit", rect.Width, rect.Height);
+				m_SubTextures[i] = SubTexture();
+				continue;
+			}
+
+			SubTexture& subTexture = m_SubTextures[i];
+			subTexture.TextureID = m_Pages[rect.Page];
+			subTexture.TexCoordMin = { (float)rect.X / pageWidth, (float)rect.Y / pageHeight };
+			subTexture.TexCoordMax = { (float)(rect.X + rect.Width) / pageWidth, (float)(rect.Y + rect.Height) / pageHeight };
+		}
+
+		m_Images.clear();
+		m_Images.shrink_to_fit();
+
+		return packed;
+	}
+
+	void TextureAtlas::BlitImage(std::vector<uint8_t>& page, const Utils::Image& image, const Utils::PackRect& rect) const
+	{
+		const uint32_t pageWidth = m_Specification.Packer.PageWidth;
+		const int32_t gutter = (int32_t)m_Specification.Packer.Gutter;
+
+		// Copy the image plus a gutter of clamped edge texels around it
+		for (int32_t y = -gutter; y < (int32_t)image.Height + gutter; y++)
+		{
+			uint32_t srcY = (uint32_t)std::clamp(y, 0, (int32_t)image.Height - 1);
+			uint8_t* dstRow = &page[((size_t)(rect.Y + y) * pageWidth + rect.X) * 4];
+			const uint8_t* srcRow = &image.Pixels[(size_t)srcY * image.Width * 4];
+
+			memcpy(dstRow, srcRow, (size_t)image.Width * 4);
+			for (int32_t x = 1; x <= gutter; x++)
+			{
+				memcpy(dstRow - x * 4, srcRow, 4);
+				memcpy(dstRow + ((size_t)image.Width + x - 1) * 4, srcRow + ((size_t)image.Width - 1) * 4, 4);
+			}
+		}
+	}
+
+	void TextureAtlas::ReleasePages()
+	{
+		if (!m_Pages.empty())
+			glDeleteTextures((GLsizei)m_Pages.size(), m_Pages.data());
+		m_Pages.clear();
+	}
+
+}
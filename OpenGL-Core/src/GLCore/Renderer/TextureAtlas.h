@@ -0,0 +1,52 @@
+#pragma once
+
+#include "SubTexture.h"
+
+#include "GLCore/Util/Texture.h"
+#include "GLCore/Util/TexturePacker.h"
+
+namespace GLCore {
+
+	struct TextureAtlasSpecification
+	{
+		Utils::TexturePackerSpecification Packer;
+		bool GenerateMips = false;
+	};
+
+	// Packs many images into as few textures as possible so the quad batcher
+	// rarely has to switch textures or flush
+	class TextureAtlas
+	{
+	public:
+		TextureAtlas(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+		~TextureAtlas();
+
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		// Queue an image for the next Build(); returns its sub-texture index
+		uint32_t Add(Utils::Image image);
+		uint32_t Add(const std::string& path);
+
+		// Packs and uploads all queued images, then releases their CPU copies
+		bool Build();
+
+		const SubTexture& GetSubTexture(uint32_t index) const { return m_SubTextures[index]; }
+		uint32_t GetSubTextureCount() const { return (uint32_t)m_SubTextures.size(); }
+
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+		GLuint GetPage(uint32_t index) const { return m_Pages[index]; }
+
+		const Utils::TexturePackerStats& GetStats() const { return m_Stats; }
+	private:
+		void BlitImage(std::vector<uint8_t>& page, const Utils::Image& image, const Utils::PackRect& rect) const;
+		void ReleasePages();
+	private:
+		TextureAtlasSpecification m_Specification;
+		std::vector<Utils::Image> m_Images;
+		std::vector<SubTexture> m_SubTextures;
+		std::vector<GLuint> m_Pages;
+		Utils::TexturePackerStats m_Stats;
+	};
+
+}
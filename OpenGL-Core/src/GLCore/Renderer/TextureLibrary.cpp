@@ -0,0 +1,221 @@
+#include "glpch.h"
+#include "TextureLibrary.h"
+
+#include "GLStateCache.h"
+
+#include "GLCore/Core/AssetPack.h"
+#include "GLCore/Util/CookedTexture.h"
+
+#include <filesystem>
+
+namespace GLCore {
+
+	Texture2D::Texture2D(GLuint rendererID, uint32_t width, uint32_t height, uint64_t memorySize, const std::string& path)
+		: m_RendererID(rendererID), m_Width(width), m_Height(height), m_MemorySize(memorySize), m_Path(path)
+	{
+	}
+
+	Texture2D::~Texture2D()
+	{
+		glDeleteTextures(1, &m_RendererID);
+	}
+
+	struct TextureCacheEntry
+	{
+		std::shared_ptr<Texture2D> Texture;
+		uint64_t UnusedSince = 0; // frame the last handle went away, 0 while referenced
+	};
+
+	struct TextureLibraryData
+	{
+		std::unordered_map<std::string, TextureCacheEntry> Cache;
+		uint64_t UnusedBudget = 0;
+		uint64_t FrameIndex = 0;
+
+		TextureLibrary::Statistics Stats;
+	};
+
+	static TextureLibraryData s_LibraryData;
+
+	void TextureLibrary::Init()
+	{
+		s_LibraryData = TextureLibraryData();
+	}
+
+	void TextureLibrary::Shutdown()
+	{
+		// Outstanding handles keep their textures alive
+		s_LibraryData.Cache.clear();
+		GLStateCache::Invalidate();
+	}
+
+	static std::string GetCacheKey(const std::string& normalizedPath, const TextureLoadParameters& parameters)
+	{
+		return normalizedPath + "|" + std::to_string(parameters.MinFilter) + "|" + std::to_string(parameters.MagFilter)
+			+ "|" + std::to_string(parameters.Wrap) + "|" + (parameters.GenerateMips ? "1" : "0");
+	}
+
+	static std::shared_ptr<Texture2D> CreateFromImage(const Utils::Image& image, const std::string& normalizedPath, const TextureLoadParameters& parameters)
+	{
+		if (!image.IsValid())
+			return nullptr;
+		GLCORE_ASSERT(image.Channels == 4, "Textures are uploaded as RGBA8!");
+
+		uint32_t levels = 1;
+		if (parameters.GenerateMips)
+		{
+			while ((std::max(image.Width, image.Height) >> levels) > 0)
+				levels++;
+		}
+
+		GLuint textureID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+		glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, parameters.MinFilter);
+		glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, parameters.MagFilter);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, parameters.Wrap);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, parameters.Wrap);
+		glTextureStorage2D(textureID, levels, GL_RGBA8, image.Width, image.Height);
+		glTextureSubImage2D(textureID, 0, 0, 0, image.Width, image.Height, GL_RGBA, GL_UNSIGNED_BYTE, image.Pixels.data());
+		if (levels > 1)
+			glGenerateTextureMipmap(textureID);
+
+		uint64_t memorySize = 0;
+		for (uint32_t level = 0; level < levels; level++)
+			memorySize += (uint64_t)std::max(1u, image.Width >> level) * std::max(1u, image.Height >> level) * 4;
+		return std::make_shared<Texture2D>(textureID, image.Width, image.Height, memorySize, normalizedPath);
+	}
+
+	static std::shared_ptr<Texture2D> CreateFromCooked(const std::string& path, const std::string& normalizedPath, const TextureLoadParameters& parameters)
+	{
+		Utils::CookedTextureInfo info;
+		GLuint textureID = Utils::LoadCookedTexture(path, &info);
+		if (!textureID)
+			return nullptr;
+		s_LibraryData.Stats.CookedLoads++;
+
+		// Mip filters only apply when the file has the levels
+		glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, info.LevelCount > 1 ? parameters.MinFilter : GL_LINEAR);
+		glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, parameters.MagFilter);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, parameters.Wrap);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, parameters.Wrap);
+		return std::make_shared<Texture2D>(textureID, info.Width, info.Height, info.MemorySize, normalizedPath);
+	}
+
+	// image is decoded from path here when the caller has not done so already
+	static std::shared_ptr<Texture2D> LoadTexture(const std::string& path, const Utils::Image* image, const TextureLoadParameters& parameters)
+	{
+		s_LibraryData.Stats.Requests++;
+
+		std::string normalizedPath = AssetPack::NormalizePath(path);
+		std::string key = GetCacheKey(normalizedPath, parameters);
+
+		auto it = s_LibraryData.Cache.find(key);
+		if (it != s_LibraryData.Cache.end())
+		{
+			s_LibraryData.Stats.Hits++;
+			it->second.UnusedSince = 0;
+			return it->second.Texture;
+		}
+
+		std::shared_ptr<Texture2D> texture;
+		if (image)
+		{
+			texture = CreateFromImage(*image, normalizedPath, parameters);
+		}
+		else if (std::filesystem::path(path).extension() == ".gltex")
+		{
+			texture = CreateFromCooked(path, normalizedPath, parameters);
+		}
+		else
+		{
+			Utils::Image decoded = Utils::Image::FromFile(path, 4);
+			if (decoded.IsValid())
+				s_LibraryData.Stats.Decodes++;
+			texture = CreateFromImage(decoded, normalizedPath, parameters);
+		}
+		if (!texture)
+			return nullptr;
+
+		s_LibraryData.Cache[key] = { texture, 0 };
+		s_LibraryData.Stats.ResidentCount++;
+		s_LibraryData.Stats.ResidentBytes += texture->GetMemorySize();
+		return texture;
+	}
+
+	std::shared_ptr<Texture2D> TextureLibrary::Load(const std::string& path, const TextureLoadParameters& parameters)
+	{
+		return LoadTexture(path, nullptr, parameters);
+	}
+
+	std::shared_ptr<Texture2D> TextureLibrary::Load(const std::string& path, const Utils::Image& image, const TextureLoadParameters& parameters)
+	{
+		return LoadTexture(path, &image, parameters);
+	}
+
+	void TextureLibrary::Update()
+	{
+		uint64_t frame = ++s_LibraryData.FrameIndex;
+		Statistics& stats = s_LibraryData.Stats;
+
+		// The cache's own reference is the only one left once every handle is gone
+		std::vector<std::pair<uint64_t, const std::string*>> unused;
+		stats.UnusedBytes = 0;
+		for (auto& [key, entry] : s_LibraryData.Cache)
+		{
+			if (entry.Texture.use_count() > 1)
+			{
+				entry.UnusedSince = 0;
+				continue;
+			}
+
+			if (entry.UnusedSince == 0)
+				entry.UnusedSince = frame;
+			unused.push_back({ entry.UnusedSince, &key });
+			stats.UnusedBytes += entry.Texture->GetMemorySize();
+		}
+
+		if (stats.UnusedBytes > s_LibraryData.UnusedBudget)
+		{
+			std::sort(unused.begin(), unused.end());
+			for (const auto& [unusedSince, key] : unused)
+			{
+				if (stats.UnusedBytes <= s_LibraryData.UnusedBudget)
+					break;
+
+				auto it = s_LibraryData.Cache.find(*key);
+				uint64_t size = it->second.Texture->GetMemorySize();
+				stats.UnusedBytes -= size;
+				stats.ResidentBytes -= size;
+				stats.ResidentCount--;
+				stats.Evictions++;
+				s_LibraryData.Cache.erase(it);
+			}
+
+			// Names of deleted textures may be handed out again
+			GLStateCache::Invalidate();
+		}
+
+		stats.UnusedCount = 0;
+		for (const auto& [key, entry] : s_LibraryData.Cache)
+		{
+			if (entry.UnusedSince != 0)
+				stats.UnusedCount++;
+		}
+	}
+
+	void TextureLibrary::SetUnusedMemoryBudget(uint64_t bytes)
+	{
+		s_LibraryData.UnusedBudget = bytes;
+	}
+
+	uint64_t TextureLibrary::GetUnusedMemoryBudget()
+	{
+		return s_LibraryData.UnusedBudget;
+	}
+
+	const TextureLibrary::Statistics& TextureLibrary::GetStats()
+	{
+		return s_LibraryData.Stats;
+	}
+
+}
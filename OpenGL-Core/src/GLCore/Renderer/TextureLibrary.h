@@ -0,0 +1,86 @@
+#pragma once
+
+#include "GLCore/Util/Texture.h"
+
+#include <memory>
+#include <string>
+
+namespace GLCore {
+
+	struct TextureLoadParameters
+	{
+		GLenum MinFilter = GL_LINEAR;
+		GLenum MagFilter = GL_NEAREST;
+		GLenum Wrap = GL_CLAMP_TO_EDGE;
+		bool GenerateMips = false;
+	};
+
+	// GL texture shared through TextureLibrary handles; the storage is freed
+	// when the last handle and the library's cache entry are gone
+	class Texture2D
+	{
+	public:
+		Texture2D(GLuint rendererID, uint32_t width, uint32_t height, uint64_t memorySize, const std::string& path);
+		~Texture2D();
+
+		Texture2D(const Texture2D&) = delete;
+		Texture2D& operator=(const Texture2D&) = delete;
+
+		GLuint GetRendererID() const { return m_RendererID; }
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		const std::string& GetPath() const { return m_Path; }
+
+		// Bytes of GPU storage, all mip levels included
+		uint64_t GetMemorySize() const { return m_MemorySize; }
+	private:
+		GLuint m_RendererID = 0;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint64_t m_MemorySize = 0;
+		std::string m_Path;
+	};
+
+	// Path keyed texture cache shared by every layer. Loading a path that is
+	// already resident (same path after AssetPack::NormalizePath, same load
+	// parameters) returns the existing texture without decoding or uploading
+	// anything. Textures nobody holds a handle to any more stay cached up to
+	// the unused memory budget, so a layer that is detached and attached again
+	// does not reload them; beyond the budget Update() evicts the ones
+	// released longest ago.
+	class TextureLibrary
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// Returns nullptr if the image cannot be loaded. Cooked .gltex files
+		// (see OpenGL-TextureCooker) are uploaded as stored: their own format
+		// and mip chain, parameters.GenerateMips is ignored.
+		static std::shared_ptr<Texture2D> Load(const std::string& path, const TextureLoadParameters& parameters = TextureLoadParameters());
+		// For images the caller decoded anyway (e.g. to also pack them into an atlas or
+		// texture array): image is uploaded and cached under path unless path is resident
+		static std::shared_ptr<Texture2D> Load(const std::string& path, const Utils::Image& image, const TextureLoadParameters& parameters = TextureLoadParameters());
+
+		// Evicts unused textures over the budget; called by Application once per frame
+		static void Update();
+
+		// Bytes of unreferenced textures kept around for reuse, 0 frees them on the next Update()
+		static void SetUnusedMemoryBudget(uint64_t bytes);
+		static uint64_t GetUnusedMemoryBudget();
+
+		struct Statistics
+		{
+			uint32_t Requests = 0;
+			uint32_t Hits = 0;        // served from the cache
+			uint32_t Decodes = 0;
+			uint32_t CookedLoads = 0; // .gltex uploads, no decode
+			uint32_t Evictions = 0;
+			uint32_t ResidentCount = 0;
+			uint32_t UnusedCount = 0;
+			uint64_t ResidentBytes = 0;
+			uint64_t UnusedBytes = 0;
+		};
+		static const Statistics& GetStats();
+	};
+
+}
@@ -0,0 +1,59 @@
+#include "glpch.h"
+#include "TextureSlotManager.h"
+
+#include "GLStateCache.h"
+
+namespace GLCore {
+
+	void TextureSlotManager::Init(uint32_t maxSlots, GLuint defaultTexture)
+	{
+		m_Slots.assign(maxSlots, 0);
+		m_Slots[0] = defaultTexture;
+		Reset();
+	}
+
+	int32_t TextureSlotManager::Acquire(GLuint textureID)
+	{
+		if (textureID == m_LastTexture)
+			return m_LastSlot;
+
+		// Linear search is faster than hashing for a few dozen contiguous ids
+		for (uint32_t i = 0; i < m_SlotCount; i++)
+		{
+			if (m_Slots[i] == textureID)
+			{
+				m_LastTexture = textureID;
+				m_LastSlot = (int32_t)i;
+				return m_LastSlot;
+			}
+		}
+
+		if (m_SlotCount == m_Slots.size())
+			return -1;
+
+		m_Slots[m_SlotCount] = textureID;
+		m_LastTexture = textureID;
+		m_LastSlot = (int32_t)m_SlotCount++;
+		return m_LastSlot;
+	}
+
+	void TextureSlotManager::Reset()
+	{
+		m_SlotCount = 1;
+		m_LastTexture = m_Slots[0];
+		m_LastSlot = 0;
+	}
+
+	void TextureSlotManager::Bind() const
+	{
+		GLStateCache::BindTextures(0, m_SlotCount, m_Slots.data());
+	}
+
+	uint32_t TextureSlotManager::QueryMaxTextureSlots()
+	{
+		GLint maxUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+		return (uint32_t)maxUnits;
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+
+namespace GLCore {
+
+	// Assigns texture units to textures as they are submitted to a batch.
+	// Slot 0 is reserved for a default (white) texture. When Acquire returns -1
+	// every unit is taken and the caller has to flush the batch and Reset().
+	class TextureSlotManager
+	{
+	public:
+		void Init(uint32_t maxSlots, GLuint defaultTexture);
+
+		int32_t Acquire(GLuint textureID);
+		void Reset();
+
+		// Binds all used slots with a single multi-bind call
+		void Bind() const;
+
+		uint32_t GetSlotCount() const { return m_SlotCount; }
+		uint32_t GetMaxSlots() const { return (uint32_t)m_Slots.size(); }
+
+		// GL_MAX_TEXTURE_IMAGE_UNITS of the current context
+		static uint32_t QueryMaxTextureSlots();
+	private:
+		std::vector<GLuint> m_Slots;
+		uint32_t m_SlotCount = 1;
+
+		// Consecutive quads very often share a texture
+		GLuint m_LastTexture = 0;
+		int32_t m_LastSlot = 0;
+	};
+
+}
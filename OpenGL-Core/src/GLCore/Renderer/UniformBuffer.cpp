@@ -0,0 +1,181 @@
+#include "glpch.h"
+#include "UniformBuffer.h"
+
+#include "GLStateCache.h"
+#include "StreamBuffer.h"
+
+#include "GLCore/Util/OrthographicCamera.h"
+#include "GLCore/Util/ShaderPreprocessor.h"
+
+namespace GLCore {
+
+	UniformBuffer::UniformBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void UniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		GLCORE_ASSERT(offset + size <= m_Size, "Uniform buffer write out of range!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void UniformBuffer::Bind(GLuint binding) const
+	{
+		GLStateCache::BindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, 0, m_Size);
+	}
+
+	struct CameraSnapshot
+	{
+		CameraUniforms Data;
+		uint32_t RingOffset = 0;
+		bool InRing = false;
+	};
+
+	struct FrameUniformsData
+	{
+		std::unique_ptr<UniformBuffer> CameraBuffer;
+		// This frame's cameras in the order they were set, the last one is in CameraBuffer
+		std::vector<CameraSnapshot> Cameras;
+
+		std::unique_ptr<StreamBuffer> DrawStream;
+		uint32_t UniformAlignment = 256;
+
+		FrameUniforms::Statistics Stats;
+	};
+
+	static FrameUniformsData s_FrameData;
+
+	static const char* s_CameraBlockSource = R"(
+		#pragma once
+
+		layout (std140, binding = 0) uniform Camera
+		{
+			mat4 u_ViewProjection;
+			mat4 u_View;
+			mat4 u_Projection;
+			vec4 u_CameraPosition;
+		};
+	)";
+
+	void FrameUniforms::Init()
+	{
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		s_FrameData.UniformAlignment = (uint32_t)alignment;
+
+		s_FrameData.CameraBuffer = std::make_unique<UniformBuffer>((uint32_t)sizeof(CameraUniforms));
+		s_FrameData.Cameras.clear();
+
+		s_FrameData.DrawStream = std::make_unique<StreamBuffer>(MaxDrawBytesPerFrame);
+
+		Utils::ShaderPreprocessor::AddVirtualFile(CameraInclude, s_CameraBlockSource);
+	}
+
+	void FrameUniforms::Shutdown()
+	{
+		s_FrameData.CameraBuffer.reset();
+		s_FrameData.DrawStream.reset();
+		s_FrameData.Cameras.clear();
+		GLStateCache::Invalidate();
+	}
+
+	void FrameUniforms::SetCamera(const Utils::OrthographicCamera& camera)
+	{
+		CameraUniforms uniforms;
+		uniforms.ViewProjection = camera.GetViewProjectionMatrix();
+		uniforms.View = camera.GetViewMatrix();
+		uniforms.Projection = camera.GetProjectionMatrix();
+		uniforms.Position = glm::vec4(camera.GetPosition(), 1.0f);
+		SetCamera(uniforms);
+	}
+
+	void FrameUniforms::SetCamera(const CameraUniforms& camera)
+	{
+		// Several layers usually render with the same camera in a frame
+		std::vector<CameraSnapshot>& cameras = s_FrameData.Cameras;
+		if (!cameras.empty() && memcmp(&cameras.back().Data, &camera, sizeof(camera)) == 0)
+		{
+			s_FrameData.Stats.CameraSkips++;
+		}
+		else
+		{
+			cameras.push_back({ camera });
+			s_FrameData.CameraBuffer->SetData(&camera, (uint32_t)sizeof(camera));
+			s_FrameData.Stats.CameraUploads++;
+		}
+
+		// Elided by the cache unless something else was bound there
+		s_FrameData.CameraBuffer->Bind(CameraBinding);
+	}
+
+	uint32_t FrameUniforms::GetCameraIndex()
+	{
+		return s_FrameData.Cameras.empty() ? NoCamera : (uint32_t)s_FrameData.Cameras.size() - 1;
+	}
+
+	void FrameUniforms::BindCamera(uint32_t index)
+	{
+		std::vector<CameraSnapshot>& cameras = s_FrameData.Cameras;
+		if (index >= cameras.size())
+			return;
+
+		if (index == cameras.size() - 1)
+		{
+			s_FrameData.CameraBuffer->Bind(CameraBinding);
+			return;
+		}
+
+		// CameraBuffer already holds a later camera, draws queued before it read their copy from the ring
+		CameraSnapshot& snapshot = cameras[index];
+		if (!snapshot.InRing)
+		{
+			snapshot.RingOffset = s_FrameData.DrawStream->Upload(&snapshot.Data, (uint32_t)sizeof(CameraUniforms), s_FrameData.UniformAlignment);
+			snapshot.InRing = true;
+			s_FrameData.Stats.CameraSnapshots++;
+		}
+		GLStateCache::BindBufferRange(GL_UNIFORM_BUFFER, CameraBinding, s_FrameData.DrawStream->GetRendererID(), snapshot.RingOffset, (uint32_t)sizeof(CameraUniforms));
+	}
+
+	void FrameUniforms::PushDrawUniforms(const void* data, uint32_t size, GLuint binding)
+	{
+		uint32_t offset = s_FrameData.DrawStream->Upload(data, size, s_FrameData.UniformAlignment);
+		GLStateCache::BindBufferRange(GL_UNIFORM_BUFFER, binding, s_FrameData.DrawStream->GetRendererID(), offset, size);
+
+		s_FrameData.Stats.DrawPushes++;
+		s_FrameData.Stats.DrawBytes += size;
+	}
+
+	void FrameUniforms::EndFrame()
+	{
+		s_FrameData.DrawStream->Fence();
+
+		// The current camera carries over into the next frame
+		std::vector<CameraSnapshot>& cameras = s_FrameData.Cameras;
+		if (cameras.size() > 1)
+		{
+			cameras.front() = cameras.back();
+			cameras.resize(1);
+		}
+		if (!cameras.empty())
+			cameras.front().InRing = false;
+	}
+
+	const FrameUniforms::Statistics& FrameUniforms::GetStats()
+	{
+		return s_FrameData.Stats;
+	}
+
+	void FrameUniforms::ResetStats()
+	{
+		s_FrameData.Stats = Statistics();
+	}
+
+}
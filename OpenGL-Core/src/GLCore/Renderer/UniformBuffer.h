@@ -0,0 +1,99 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <memory>
+
+namespace GLCore {
+
+	namespace Utils { class OrthographicCamera; }
+
+	// Fixed size GL_UNIFORM_BUFFER updated with glNamedBufferSubData, for
+	// blocks that change rarely; per-draw data goes through FrameUniforms
+	class UniformBuffer
+	{
+	public:
+		UniformBuffer(uint32_t size);
+		~UniformBuffer();
+
+		UniformBuffer(const UniformBuffer&) = delete;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0);
+		void Bind(GLuint binding) const;
+
+		GLuint GetRendererID() const { return m_RendererID; }
+		uint32_t GetSize() const { return m_Size; }
+	private:
+		GLuint m_RendererID = 0;
+		uint32_t m_Size = 0;
+	};
+
+	// std140 mirror of the shared Camera block
+	struct CameraUniforms
+	{
+		glm::mat4 ViewProjection;
+		glm::mat4 View;
+		glm::mat4 Projection;
+		glm::vec4 Position;
+	};
+
+	static_assert(sizeof(CameraUniforms) == 208, "CameraUniforms must match the std140 Camera block");
+
+	// Uniform data shared by every shader in a frame. The camera lives in one
+	// block at a fixed binding, uploaded only when it changes, so programs no
+	// longer need their own u_ViewProjection. Shaders get the block with
+	//
+	//   #include "GLCore/Camera.glsl"
+	//
+	// which declares u_ViewProjection, u_View, u_Projection and u_CameraPosition.
+	// Every distinct camera set in a frame is kept as a snapshot; RenderQueue
+	// stores the current one with each command and binds it again at Flush,
+	// so queued draws see the camera they were submitted with.
+	//
+	// Other per-draw blocks are copied into a ring of uniform memory and bound
+	// with glBindBufferRange, so draws that only differed in their uniforms
+	// stop needing glUniform* calls between them. Storage buffer data indexed
+	// per draw is what RenderQueue's DrawData provides.
+	class FrameUniforms
+	{
+	public:
+		static const GLuint CameraBinding = 0;
+		static const GLuint DrawBinding = 1;
+		static const uint32_t NoCamera = 0xffffffff;
+		// Virtual include with the Camera block, registered by Init()
+		static constexpr const char* CameraInclude = "GLCore/Camera.glsl";
+		// Everything pushed in one frame has to fit, older frames are fenced
+		static const uint32_t MaxDrawBytesPerFrame = 256 * 1024;
+
+		static void Init();
+		static void Shutdown();
+
+		static void SetCamera(const Utils::OrthographicCamera& camera);
+		static void SetCamera(const CameraUniforms& camera);
+
+		// Snapshot of the camera set last, NoCamera before the first SetCamera
+		static uint32_t GetCameraIndex();
+		// Binds a snapshot of this frame at CameraBinding; older ones are copied into the ring once
+		static void BindCamera(uint32_t index);
+
+		// Copies a std140 block into the ring and binds it at binding until the next push there
+		static void PushDrawUniforms(const void* data, uint32_t size, GLuint binding = DrawBinding);
+
+		// Fences this frame's ring region; called by Application after RenderQueue::Flush
+		static void EndFrame();
+
+		struct Statistics
+		{
+			uint32_t CameraUploads = 0;
+			uint32_t CameraSkips = 0; // SetCamera with an unchanged camera
+			uint32_t CameraSnapshots = 0; // earlier cameras copied into the ring for queued draws
+			uint32_t DrawPushes = 0;
+			uint64_t DrawBytes = 0;
+		};
+		static const Statistics& GetStats();
+		static void ResetStats();
+	};
+
+}
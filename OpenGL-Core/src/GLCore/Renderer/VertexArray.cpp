@@ -0,0 +1,67 @@
+#include "glpch.h"
+#include "VertexArray.h"
+
+#include "GLStateCache.h"
+
+namespace GLCore {
+
+	VertexArray::VertexArray()
+	{
+		glCreateVertexArrays(1, &m_RendererID);
+	}
+
+	VertexArray::~VertexArray()
+	{
+		glDeleteVertexArrays(1, &m_RendererID);
+	}
+
+	void VertexArray::Bind() const
+	{
+		GLStateCache::BindVertexArray(m_RendererID);
+	}
+
+	void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer, GLuint divisor)
+	{
+		const BufferLayout& layout = vertexBuffer->GetLayout();
+		GLCORE_ASSERT(layout.GetElements().size(), "Vertex buffer has no layout!");
+
+		const GLuint binding = GetNextBinding();
+		glVertexArrayVertexBuffer(m_RendererID, binding, vertexBuffer->GetRendererID(), 0, layout.GetStride());
+		glVertexArrayBindingDivisor(m_RendererID, binding, divisor);
+		m_NextAttribute = ApplyLayout(m_RendererID, layout, binding, m_NextAttribute);
+
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void VertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
+	{
+		glVertexArrayElementBuffer(m_RendererID, indexBuffer->GetRendererID());
+		m_IndexBuffer = indexBuffer;
+	}
+
+	GLuint VertexArray::ApplyLayout(GLuint vertexArray, const BufferLayout& layout, GLuint binding, GLuint firstAttribute)
+	{
+		GLuint attribute = firstAttribute;
+		for (const BufferElement& element : layout)
+		{
+			const GLint count = (GLint)element.GetComponentCount();
+			const GLenum type = element.GetGLBaseType();
+			const uint32_t locationSize = element.Size / element.GetLocationCount();
+
+			for (uint32_t i = 0; i < element.GetLocationCount(); i++)
+			{
+				const GLuint offset = element.Offset + locationSize * i;
+
+				glEnableVertexArrayAttrib(vertexArray, attribute);
+				if (element.IsInteger())
+					glVertexArrayAttribIFormat(vertexArray, attribute, count, type, offset);
+				else
+					glVertexArrayAttribFormat(vertexArray, attribute, count, type, element.IsNormalized() ? GL_TRUE : GL_FALSE, offset);
+				glVertexArrayAttribBinding(vertexArray, attribute, binding);
+				attribute++;
+			}
+		}
+		return attribute;
+	}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Buffer.h"
+
+#include <memory>
+
+namespace GLCore {
+
+	// Vertex array set up purely through DSA: nothing is bound while the
+	// attributes are described, so creating one never disturbs the state the
+	// renderer (or GLStateCache) thinks is current.
+	class VertexArray
+	{
+	public:
+		VertexArray();
+		~VertexArray();
+
+		VertexArray(const VertexArray&) = delete;
+		VertexArray& operator=(const VertexArray&) = delete;
+
+		void Bind() const;
+
+		// Gives the buffer the next binding point and its elements the next
+		// attribute locations, in layout order. divisor = 1 for per-instance data.
+		void AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer, GLuint divisor = 0);
+		void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer);
+
+		const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
+		const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+
+		// First binding point / attribute location not taken by AddVertexBuffer,
+		// for buffers attached to the raw vertex array by other systems
+		GLuint GetNextBinding() const { return (GLuint)m_VertexBuffers.size(); }
+		GLuint GetNextAttribute() const { return m_NextAttribute; }
+
+		GLuint GetRendererID() const { return m_RendererID; }
+
+		// Describes layout as attributes firstAttribute.. sourced from binding and
+		// returns the next free location. The buffer itself is attached separately
+		// (glVertexArrayVertexBuffer), so streamed buffers can move it every draw.
+		static GLuint ApplyLayout(GLuint vertexArray, const BufferLayout& layout, GLuint binding, GLuint firstAttribute = 0);
+	private:
+		GLuint m_RendererID = 0;
+		GLuint m_NextAttribute = 0;
+		std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+	};
+
+}
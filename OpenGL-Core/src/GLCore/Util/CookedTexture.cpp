@@ -0,0 +1,167 @@
+#include "glpch.h"
+#include "CookedTexture.h"
+
+#include "GLCore/Core/AssetPack.h"
+
+// EXT_texture_compression_s3tc is not part of the core profile loader
+#define GLCORE_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GLCORE_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+
+namespace GLCore::Utils {
+
+	const char* GetCookedTextureFormatName(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::RGBA8: return "RGBA8";
+		case CookedTextureFormat::BC1:   return "BC1";
+		case CookedTextureFormat::BC3:   return "BC3";
+		case CookedTextureFormat::BC7:   return "BC7";
+		}
+		return "Unknown";
+	}
+
+	GLenum GetCookedTextureInternalFormat(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::RGBA8: return GL_RGBA8;
+		case CookedTextureFormat::BC1:   return GLCORE_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case CookedTextureFormat::BC3:   return GLCORE_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case CookedTextureFormat::BC7:   return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+		return 0;
+	}
+
+	uint64_t GetCookedTextureLevelSize(CookedTextureFormat format, uint32_t width, uint32_t height)
+	{
+		const uint64_t blocks = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+		switch (format)
+		{
+		case CookedTextureFormat::RGBA8: return (uint64_t)width * height * 4;
+		case CookedTextureFormat::BC1:   return blocks * 8;
+		case CookedTextureFormat::BC3:   return blocks * 16;
+		case CookedTextureFormat::BC7:   return blocks * 16;
+		}
+		return 0;
+	}
+
+	static bool HasExtension(const char* name)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++)
+		{
+			if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool IsCookedTextureFormatSupported(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::RGBA8:
+			return true;
+		case CookedTextureFormat::BC1:
+		case CookedTextureFormat::BC3:
+		{
+			static const bool s_S3TCSupported = HasExtension("GL_EXT_texture_compression_s3tc");
+			return s_S3TCSupported;
+		}
+		case CookedTextureFormat::BC7:
+			return GLAD_GL_VERSION_4_2;
+		}
+		return false;
+	}
+
+	GLuint CreateCookedTexture(const void* data, size_t size, CookedTextureInfo* outInfo)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+
+		CookedTextureHeader header;
+		if (size < sizeof(header))
+		{
+			LOG_ERROR("Cooked texture is truncated");
+			return 0;
+		}
+		memcpy(&header, bytes, sizeof(header));
+
+		if (header.Magic != CookedTextureHeader::ExpectedMagic || header.Version != CookedTextureHeader::CurrentVersion)
+		{
+			LOG_ERROR("Not a version {0} cooked texture", CookedTextureHeader::CurrentVersion);
+			return 0;
+		}
+		if (header.LevelCount == 0 || size < sizeof(header) + header.LevelCount * sizeof(CookedTextureLevel))
+		{
+			LOG_ERROR("Cooked texture is truncated");
+			return 0;
+		}
+		if (!IsCookedTextureFormatSupported(header.Format))
+		{
+			LOG_ERROR("Cooked texture format {0} is not supported", GetCookedTextureFormatName(header.Format));
+			return 0;
+		}
+
+		const CookedTextureLevel* levels = (const CookedTextureLevel*)(bytes + sizeof(header));
+		for (uint32_t i = 0; i < header.LevelCount; i++)
+		{
+			if (levels[i].Offset + levels[i].Size > size || levels[i].Size != GetCookedTextureLevelSize(header.Format, levels[i].Width, levels[i].Height))
+			{
+				LOG_ERROR("Cooked texture level {0} is corrupt", i);
+				return 0;
+			}
+		}
+
+		const GLenum internalFormat = GetCookedTextureInternalFormat(header.Format);
+
+		GLuint textureID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+		glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, header.LevelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(textureID, GL_TEXTURE_MAX_LEVEL, header.LevelCount - 1);
+		glTextureStorage2D(textureID, header.LevelCount, internalFormat, header.Width, header.Height);
+
+		uint64_t memorySize = 0;
+		for (uint32_t i = 0; i < header.LevelCount; i++)
+		{
+			const CookedTextureLevel& level = levels[i];
+			const void* pixels = bytes + level.Offset;
+			if (header.Format == CookedTextureFormat::RGBA8)
+				glTextureSubImage2D(textureID, i, 0, 0, level.Width, level.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			else
+				glCompressedTextureSubImage2D(textureID, i, 0, 0, level.Width, level.Height, internalFormat, (GLsizei)level.Size, pixels);
+			memorySize += level.Size;
+		}
+
+		if (outInfo)
+		{
+			outInfo->Format = header.Format;
+			outInfo->Width = header.Width;
+			outInfo->Height = header.Height;
+			outInfo->LevelCount = header.LevelCount;
+			outInfo->MemorySize = memorySize;
+		}
+		return textureID;
+	}
+
+	GLuint LoadCookedTexture(const std::string& path, CookedTextureInfo* outInfo)
+	{
+		// Packed textures are uploaded straight from the mapping
+		AssetData data = AssetPack::Read(path);
+		if (!data)
+		{
+			LOG_ERROR("Could not open cooked texture '{0}'", path);
+			return 0;
+		}
+
+		GLuint textureID = CreateCookedTexture(data.GetData(), data.GetSize(), outInfo);
+		if (!textureID)
+			LOG_ERROR("Could not load cooked texture '{0}'", path);
+		return textureID;
+	}
+
+}
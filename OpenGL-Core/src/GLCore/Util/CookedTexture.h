@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+
+#include <glad/glad.h>
+
+namespace GLCore::Utils {
+
+	// Payload of a cooked texture, see the OpenGL-TextureCooker tool
+	enum class CookedTextureFormat : uint32_t
+	{
+		RGBA8 = 0,
+		BC1,  // 4 bpp, opaque or 1-bit alpha (EXT_texture_compression_s3tc)
+		BC3,  // 8 bpp, BC1 color plus interpolated alpha (EXT_texture_compression_s3tc)
+		BC7   // 8 bpp, high quality RGBA (core since GL 4.2)
+	};
+
+	// A .gltex file is this header, LevelCount level descriptors and
+	// the level payloads, each starting on a 16 byte boundary. Level 0 is the
+	// full image; rows (and block rows) are stored bottom first like GL expects,
+	// so the payloads can go straight into glTextureSubImage2D /
+	// glCompressedTextureSubImage2D.
+	struct CookedTextureHeader
+	{
+		static constexpr uint32_t ExpectedMagic = 0x58544c47; // "GLTX"
+		static constexpr uint32_t CurrentVersion = 1;
+
+		uint32_t Magic = ExpectedMagic;
+		uint32_t Version = CurrentVersion;
+		CookedTextureFormat Format = CookedTextureFormat::RGBA8;
+		uint32_t Width = 0, Height = 0;
+		uint32_t LevelCount = 0;
+	};
+
+	struct CookedTextureLevel
+	{
+		uint32_t Width, Height;
+		uint64_t Offset; // from the start of the file
+		uint64_t Size;
+	};
+
+	static_assert(sizeof(CookedTextureHeader) == 24, "CookedTextureHeader is part of the file format");
+	static_assert(sizeof(CookedTextureLevel) == 24, "CookedTextureLevel is part of the file format");
+
+	struct CookedTextureInfo
+	{
+		CookedTextureFormat Format = CookedTextureFormat::RGBA8;
+		uint32_t Width = 0, Height = 0;
+		uint32_t LevelCount = 0;
+		uint64_t MemorySize = 0; // GPU bytes, all levels
+	};
+
+	const char* GetCookedTextureFormatName(CookedTextureFormat format);
+	GLenum GetCookedTextureInternalFormat(CookedTextureFormat format);
+	// Bytes of one level of width x height
+	uint64_t GetCookedTextureLevelSize(CookedTextureFormat format, uint32_t width, uint32_t height);
+	bool IsCookedTextureFormatSupported(CookedTextureFormat format);
+
+	// Uploads an in-memory .gltex without decoding anything; data only has to
+	// live for the duration of the call. Returns 0 if it is malformed or its
+	// format is not supported by the context.
+	GLuint CreateCookedTexture(const void* data, size_t size, CookedTextureInfo* outInfo = nullptr);
+	GLuint LoadCookedTexture(const std::string& path, CookedTextureInfo* outInfo = nullptr);
+
+}
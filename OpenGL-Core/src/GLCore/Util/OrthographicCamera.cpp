@@ -26,4 +26,22 @@ namespace GLCore::Utils {
 		m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 	}
 
+	void OrthographicCamera::GetVisibleBounds(glm::vec2& outMin, glm::vec2& outMax) const
+	{
+		glm::mat4 inverseViewProjection = glm::inverse(m_ViewProjectionMatrix);
+		const glm::vec4 corners[4] = {
+			{ -1.0f, -1.0f, 0.0f, 1.0f }, { 1.0f, -1.0f, 0.0f, 1.0f },
+			{ 1.0f, 1.0f, 0.0f, 1.0f }, { -1.0f, 1.0f, 0.0f, 1.0f }
+		};
+
+		outMin = glm::vec2(std::numeric_limits<float>::max());
+		outMax = glm::vec2(-std::numeric_limits<float>::max());
+		for (const glm::vec4& corner : corners)
+		{
+			glm::vec4 world = inverseViewProjection * corner;
+			outMin = glm::min(outMin, glm::vec2(world.x, world.y));
+			outMax = glm::max(outMax, glm::vec2(world.x, world.y));
+		}
+	}
+
 }
\ No newline at end of file
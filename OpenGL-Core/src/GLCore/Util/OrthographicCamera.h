@@ -20,6 +20,9 @@ namespace GLCore::Utils {
 		const glm::mat4& GetProjectionMatrix() const { return m_ProjectionMatrix; }
 		const glm::mat4& GetViewMatrix() const { return m_ViewMatrix; }
 		const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjectionMatrix; }
+
+		// World space box around everything the camera sees (accounts for rotation)
+		void GetVisibleBounds(glm::vec2& outMin, glm::vec2& outMax) const;
 	private:
 		void RecalculateViewMatrix();
 	private:
@@ -1,44 +1,90 @@
 #include "glpch.h"
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "ShaderHotReload.h"
+#include "Timer.h"
 
-#include <fstream>
+#include "GLCore/Core/AssetPack.h"
+#include "GLCore/Renderer/GLStateCache.h"
+
+#include <glfw/glfw3.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <thread>
 
 namespace GLCore::Utils {
 
-	static std::string ReadFileAsString(const std::string& filepath)
+	struct ShaderVariant
 	{
-		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary);
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			result.resize((size_t)in.tellg());
-			in.seekg(0, std::ios::beg);
-			in.read(&result[0], result.size());
-			in.close();
-		}
-		else
+		std::string Base;
+		uint32_t Flags;
+		Shader* Program;
+	};
+
+	struct ShaderVariantData
+	{
+		// Keyed by a hash of base and flags, so a hit needs no string building
+		std::unordered_map<uint64_t, ShaderVariant> Variants;
+		// Keyed by the shader cache key of the expanded sources
+		std::unordered_map<uint64_t, std::unique_ptr<Shader>> Programs;
+
+		Shader::VariantStatistics Stats;
+		Shader::WarmupStatistics WarmupStats;
+	};
+
+	static ShaderVariantData s_VariantData;
+
+	static const char* s_VariantDefines[] = { "TEXTURED", "TEXTURE_ARRAY", "VERTEX_PULLING" };
+
+	// GL_KHR_parallel_shader_compile is not part of the generated loader; the
+	// ARB variant has the same enum and signature
+	static const GLenum s_CompletionStatus = 0x91B1; // GL_COMPLETION_STATUS_KHR
+	using MaxShaderCompilerThreadsFn = void (APIENTRY*)(GLuint count);
+
+	static uint64_t GetVariantKey(std::string_view base, uint32_t flags)
+	{
+		// FNV-1a
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (char c : base)
 		{
-			LOG_ERROR("Could not open file '{0}'", filepath);
+			hash ^= (uint8_t)c;
+			hash *= 0x100000001b3ull;
 		}
+		hash ^= flags;
+		hash *= 0x100000001b3ull;
+		return hash;
+	}
 
-		return result;
+	static void LogSourceFiles(const PreprocessedShader& shader)
+	{
+		// Compile logs only have source string numbers
+		for (size_t i = 0; shader.Files.size() > 1 && i < shader.Files.size(); i++)
+			LOG_ERROR("  source {0}: {1}", i, shader.Files[i]);
 	}
 
 	Shader::~Shader()
 	{
+		if (!m_VertexPath.empty())
+			ShaderHotReload::Unregister(this);
 		glDeleteProgram(m_RendererID);
 	}
 
-	GLuint Shader::CompileShader(GLenum type, const std::string& source)
+	// Only hands the source to the driver; with a threaded compiler this returns before the compile is done
+	GLuint Shader::CompileShader(GLenum type, std::string_view source)
 	{
 		GLuint shader = glCreateShader(type);
 
-		const GLchar* sourceCStr = source.c_str();
-		glShaderSource(shader, 1, &sourceCStr, 0);
+		// Sized, so sources can come straight out of an asset pack without a terminator
+		const GLchar* sourceData = source.data();
+		const GLint sourceLength = (GLint)source.size();
+		glShaderSource(shader, 1, &sourceData, &sourceLength);
 
 		glCompileShader(shader);
+		return shader;
+	}
 
+	static void ReportCompileLog(GLuint shader)
+	{
 		GLint isCompiled = 0;
 		glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
 		if (isCompiled == GL_FALSE)
@@ -46,65 +92,497 @@ namespace GLCore::Utils {
 			GLint maxLength = 0;
 			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
 
-			std::vector<GLchar> infoLog(maxLength);
-			glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
-
-			glDeleteShader(shader);
+			std::vector<GLchar> infoLog(std::max(maxLength, 1));
+			glGetShaderInfoLog(shader, (GLsizei)infoLog.size(), nullptr, infoLog.data());
 
 			LOG_ERROR("{0}", infoLog.data());
 			// HZ_CORE_ASSERT(false, "Shader compilation failure!");
 		}
+	}
+
+	bool Shader::IsParallelCompileSupported()
+	{
+		static bool s_Queried = false;
+		static bool s_Supported = false;
+		if (s_Queried)
+			return s_Supported;
+		s_Queried = true;
+
+		MaxShaderCompilerThreadsFn maxShaderCompilerThreads = nullptr;
+		if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+			maxShaderCompilerThreads = (MaxShaderCompilerThreadsFn)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+		else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+			maxShaderCompilerThreads = (MaxShaderCompilerThreadsFn)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
 
+		s_Supported = maxShaderCompilerThreads != nullptr;
+		if (maxShaderCompilerThreads)
+			maxShaderCompilerThreads(0xFFFFFFFF); // as many as the driver likes
+		return s_Supported;
+	}
+
+	bool Shader::IsProgramReady(GLuint program)
+	{
+		if (!IsParallelCompileSupported())
+			return true;
+
+		GLint isComplete = GL_FALSE;
+		glGetProgramiv(program, s_CompletionStatus, &isComplete);
+		return isComplete == GL_TRUE;
+	}
+
+	Shader* Shader::FromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath, const std::vector<ShaderDefine>& defines)
+	{
+		Shader* shader = new Shader();
+		shader->LoadFromGLSLTextFiles(vertexShaderPath, fragmentShaderPath, defines);
 		return shader;
 	}
 
-	Shader* Shader::FromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+	Shader* Shader::FromGLSLSource(const std::string& vertexSource, const std::string& fragmentSource)
 	{
 		Shader* shader = new Shader();
-		shader->LoadFromGLSLTextFiles(vertexShaderPath, fragmentShaderPath);
+		shader->LoadFromPreprocessed(ShaderPreprocessor::ProcessSource(vertexSource), ShaderPreprocessor::ProcessSource(fragmentSource));
 		return shader;
 	}
-	
-	void Shader::LoadFromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+
+	std::vector<Shader*> Shader::FromGLSLSources(const std::vector<std::pair<std::string, std::string>>& sources, WarmupStatistics* stats)
 	{
-		std::string vertexSource = ReadFileAsString(vertexShaderPath);
-		std::string fragmentSource = ReadFileAsString(fragmentShaderPath);
+		WarmupStatistics batchStats;
+		Timer totalTimer;
+
+		std::vector<Shader*> shaders;
+		std::vector<PreprocessedShader> vertexSources, fragmentSources;
+		for (const auto& [vertexSource, fragmentSource] : sources)
+		{
+			shaders.push_back(new Shader());
+			vertexSources.push_back(ShaderPreprocessor::ProcessSource(vertexSource));
+			fragmentSources.push_back(ShaderPreprocessor::ProcessSource(fragmentSource));
+		}
+		batchStats.PreprocessMs = totalTimer.ElapsedMillis();
+
+		BuildBatch(shaders, vertexSources, fragmentSources, batchStats);
+		batchStats.TotalMs = totalTimer.ElapsedMillis();
+		if (stats)
+			*stats = batchStats;
+		return shaders;
+	}
+
+	static Shader* FindVariant(std::string_view base, uint32_t flags)
+	{
+		auto it = s_VariantData.Variants.find(GetVariantKey(base, flags));
+		if (it != s_VariantData.Variants.end() && it->second.Flags == flags && it->second.Base == base)
+			return it->second.Program;
+		return nullptr;
+	}
+
+	Shader* Shader::CreateVariant(std::string_view base, uint32_t flags, PreprocessedShader& vertex, PreprocessedShader& fragment)
+	{
+		std::vector<ShaderDefine> defines;
+		for (uint32_t bit = 0; bit < sizeof(s_VariantDefines) / sizeof(s_VariantDefines[0]); bit++)
+		{
+			if (flags & BIT(bit))
+				defines.push_back({ s_VariantDefines[bit] });
+		}
+
+		std::string vertexPath = std::string(base) + ".vert.glsl";
+		std::string fragmentPath = std::string(base) + ".frag.glsl";
+		vertex = ShaderPreprocessor::ProcessFile(vertexPath, defines);
+		fragment = ShaderPreprocessor::ProcessFile(fragmentPath, defines);
+
+		// Flags the sources never mention leave them unchanged, those keys share the program
+		uint64_t programKey = ShaderCache::GetKey({ vertex.Source, fragment.Source });
+		std::unique_ptr<Shader>& program = s_VariantData.Programs[programKey];
+		Shader* created = nullptr;
+		if (program)
+		{
+			s_VariantData.Stats.Shared++;
+		}
+		else
+		{
+			program = std::unique_ptr<Shader>(new Shader());
+			program->m_VertexPath = AssetPack::NormalizePath(vertexPath);
+			program->m_FragmentPath = AssetPack::NormalizePath(fragmentPath);
+			program->m_Defines = std::move(defines);
+			program->SetDependencies(vertex, fragment);
+			ShaderHotReload::Register(program.get());
+			s_VariantData.Stats.Builds++;
+			created = program.get();
+		}
+
+		s_VariantData.Variants[GetVariantKey(base, flags)] = { std::string(base), flags, program.get() };
+		s_VariantData.Stats.Variants = (uint32_t)s_VariantData.Variants.size();
+		return created;
+	}
+
+	Shader* Shader::Get(std::string_view base, uint32_t flags)
+	{
+		s_VariantData.Stats.Requests++;
+
+		if (Shader* variant = FindVariant(base, flags))
+			return variant;
+
+		PreprocessedShader vertex, fragment;
+		if (Shader* program = CreateVariant(base, flags, vertex, fragment))
+			program->LoadFromPreprocessed(vertex, fragment);
+		return FindVariant(base, flags);
+	}
+
+	Shader::WarmupStatistics Shader::Warmup(const std::vector<ShaderVariantRequest>& variants)
+	{
+		WarmupStatistics stats;
+		Timer totalTimer;
+
+		std::vector<Shader*> programs;
+		std::vector<PreprocessedShader> vertexSources, fragmentSources;
+		for (const ShaderVariantRequest& request : variants)
+		{
+			if (FindVariant(request.Base, request.Flags))
+				continue;
+
+			PreprocessedShader vertex, fragment;
+			if (Shader* program = CreateVariant(request.Base, request.Flags, vertex, fragment))
+			{
+				programs.push_back(program);
+				vertexSources.push_back(std::move(vertex));
+				fragmentSources.push_back(std::move(fragment));
+			}
+		}
+		stats.PreprocessMs = totalTimer.ElapsedMillis();
+
+		BuildBatch(programs, vertexSources, fragmentSources, stats);
+		stats.TotalMs = totalTimer.ElapsedMillis();
+
+		WarmupStatistics& total = s_VariantData.WarmupStats;
+		total.Programs += stats.Programs;
+		total.CacheHits += stats.CacheHits;
+		total.Failures += stats.Failures;
+		total.PreprocessMs += stats.PreprocessMs;
+		total.SubmitMs += stats.SubmitMs;
+		total.CollectMs += stats.CollectMs;
+		total.TotalMs += stats.TotalMs;
+		total.ParallelCompile = stats.ParallelCompile;
+		return stats;
+	}
+
+	void Shader::BuildBatch(const std::vector<Shader*>& shaders, const std::vector<PreprocessedShader>& vertexSources,
+		const std::vector<PreprocessedShader>& fragmentSources, WarmupStatistics& stats)
+	{
+		stats.ParallelCompile = IsParallelCompileSupported();
+		stats.Programs += (uint32_t)shaders.size();
+
+		// Every compile and link is handed to the driver before the first status
+		// query, which would otherwise wait for its compile while the rest queue up
+		Timer timer;
+		std::vector<PendingProgram> pending(shaders.size());
+		for (size_t i = 0; i < shaders.size(); i++)
+		{
+			if (!vertexSources[i].Success || !fragmentSources[i].Success)
+				continue;
+
+			if (shaders[i]->SubmitGLSLSource(vertexSources[i].Source, fragmentSources[i].Source, pending[i]))
+				stats.CacheHits++;
+		}
+		stats.SubmitMs = timer.ElapsedMillis();
+
+		// Programs are collected as the compiler threads finish them, so reflection and
+		// cache writes of the first ones overlap the compiles of the rest
+		timer.Reset();
+		size_t remaining = std::count_if(pending.begin(), pending.end(), [](const PendingProgram& program) { return program.Linking; });
+		while (remaining > 0)
+		{
+			size_t collected = 0;
+			for (size_t i = 0; i < shaders.size(); i++)
+			{
+				if (!pending[i].Linking || !IsProgramReady(shaders[i]->m_RendererID))
+					continue;
+
+				shaders[i]->CollectGLSLSource(pending[i]);
+				pending[i].Linking = false;
+				collected++;
+
+				if (!shaders[i]->m_RendererID)
+				{
+					LogSourceFiles(vertexSources[i]);
+					LogSourceFiles(fragmentSources[i]);
+				}
+			}
+
+			remaining -= collected;
+			if (collected == 0)
+				std::this_thread::yield();
+		}
+		stats.CollectMs = timer.ElapsedMillis();
+
+		for (Shader* shader : shaders)
+		{
+			if (!shader->m_RendererID)
+				stats.Failures++;
+		}
+	}
+
+	void Shader::ClearVariants()
+	{
+		s_VariantData.Variants.clear();
+		s_VariantData.Programs.clear();
+		s_VariantData.Stats.Variants = 0;
+	}
+
+	const Shader::VariantStatistics& Shader::GetVariantStats()
+	{
+		return s_VariantData.Stats;
+	}
+
+	const Shader::WarmupStatistics& Shader::GetWarmupStats()
+	{
+		return s_VariantData.WarmupStats;
+	}
+
+	void Shader::LoadFromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath, const std::vector<ShaderDefine>& defines)
+	{
+		m_VertexPath = AssetPack::NormalizePath(vertexShaderPath);
+		m_FragmentPath = AssetPack::NormalizePath(fragmentShaderPath);
+		m_Defines = defines;
+
+		PreprocessedShader vertex = ShaderPreprocessor::ProcessFile(m_VertexPath, m_Defines);
+		PreprocessedShader fragment = ShaderPreprocessor::ProcessFile(m_FragmentPath, m_Defines);
+		SetDependencies(vertex, fragment);
+		LoadFromPreprocessed(vertex, fragment);
+
+		// Registered even if this first compile failed, so fixing the file brings it back
+		ShaderHotReload::Register(this);
+	}
+
+	void Shader::SetDependencies(const PreprocessedShader& vertex, const PreprocessedShader& fragment)
+	{
+		m_Dependencies = vertex.Dependencies;
+		for (const std::string& dependency : fragment.Dependencies)
+		{
+			if (std::find(m_Dependencies.begin(), m_Dependencies.end(), dependency) == m_Dependencies.end())
+				m_Dependencies.push_back(dependency);
+		}
+	}
+
+	void Shader::LoadFromPreprocessed(const PreprocessedShader& vertex, const PreprocessedShader& fragment)
+	{
+		// A missing file or include has already been reported
+		if (!vertex.Success || !fragment.Success)
+			return;
+
+		LoadFromGLSLSource(vertex.Source, fragment.Source);
+		if (!m_RendererID)
+		{
+			LogSourceFiles(vertex);
+			LogSourceFiles(fragment);
+		}
+	}
+
+	void Shader::ReplaceProgram(GLuint program, std::vector<std::string> dependencies)
+	{
+		glDeleteProgram(m_RendererID);
+		m_RendererID = program;
+		m_Dependencies = std::move(dependencies);
+		Reflect();
+
+		// The old name may be cached as the bound program and GL can hand it out again
+		GLStateCache::Invalidate();
+
+		if (m_ReloadCallback)
+			m_ReloadCallback(*this);
+	}
+
+	void Shader::LoadFromGLSLSource(std::string_view vertexSource, std::string_view fragmentSource)
+	{
+		PendingProgram pending;
+		if (!SubmitGLSLSource(vertexSource, fragmentSource, pending))
+			CollectGLSLSource(pending);
+	}
+
+	bool Shader::SubmitGLSLSource(std::string_view vertexSource, std::string_view fragmentSource, PendingProgram& pending)
+	{
+		pending.CacheKey = ShaderCache::GetKey({ vertexSource, fragmentSource });
+		if (GLuint cachedProgram = ShaderCache::Load(pending.CacheKey))
+		{
+			m_RendererID = cachedProgram;
+			Reflect();
+			return true;
+		}
 
 		GLuint program = glCreateProgram();
-		int glShaderIDIndex = 0;
-			
-		GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
-		glAttachShader(program, vertexShader);
-		GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
-		glAttachShader(program, fragmentShader);
 
+		pending.VertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+		glAttachShader(program, pending.VertexShader);
+		pending.FragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+		glAttachShader(program, pending.FragmentShader);
+
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(program);
 
+		m_RendererID = program;
+		pending.Linking = true;
+		return false;
+	}
+
+	void Shader::CollectGLSLSource(const PendingProgram& pending)
+	{
+		GLuint program = m_RendererID;
+
+		// The first status query waits for the compile and link to finish
 		GLint isLinked = 0;
 		glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
 		if (isLinked == GL_FALSE)
 		{
+			ReportCompileLog(pending.VertexShader);
+			ReportCompileLog(pending.FragmentShader);
+
 			GLint maxLength = 0;
 			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
 
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+			std::vector<GLchar> infoLog(std::max(maxLength, 1));
+			glGetProgramInfoLog(program, (GLsizei)infoLog.size(), nullptr, infoLog.data());
 
 			glDeleteProgram(program);
 
-			glDeleteShader(vertexShader);
-			glDeleteShader(fragmentShader);
+			glDeleteShader(pending.VertexShader);
+			glDeleteShader(pending.FragmentShader);
 
 			LOG_ERROR("{0}", infoLog.data());
 			// HZ_CORE_ASSERT(false, "Shader link failure!");
+
+			// No program (0) until a hot reload links one; the deleted name may be reused
+			m_RendererID = 0;
+			return;
 		}
-		
-		glDetachShader(program, vertexShader);
-		glDetachShader(program, fragmentShader);
-		glDeleteShader(vertexShader);
-		glDeleteShader(fragmentShader);
 
-		m_RendererID = program;
+		ShaderCache::Store(pending.CacheKey, program);
+
+		glDetachShader(program, pending.VertexShader);
+		glDetachShader(program, pending.FragmentShader);
+		glDeleteShader(pending.VertexShader);
+		glDeleteShader(pending.FragmentShader);
+
+		Reflect();
+	}
+
+	// "u_Textures[0]" is how arrays are reported; they are looked up by their plain name
+	static std::string GetResourceName(GLuint program, GLenum interface, GLuint index, std::vector<GLchar>& buffer)
+	{
+		GLsizei length = 0;
+		glGetProgramResourceName(program, interface, index, (GLsizei)buffer.size(), &length, buffer.data());
+		std::string name(buffer.data(), length);
+		if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+			name.resize(name.size() - 3);
+		return name;
+	}
+
+	void Shader::Reflect()
+	{
+		m_Uniforms.clear();
+		m_Attributes.clear();
+		m_UniformIndices.clear();
+		m_AttributeIndices.clear();
+
+		// A failed link has already deleted the program
+		if (!glIsProgram(m_RendererID))
+			return;
+
+		std::vector<GLchar> nameBuffer;
+
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+		glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+		nameBuffer.resize(std::max(maxNameLength, 1));
+
+		const GLenum uniformProperties[] = { GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX };
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLint values[4];
+			glGetProgramResourceiv(m_RendererID, GL_UNIFORM, i, 4, uniformProperties, 4, nullptr, values);
+
+			// Block members have no location, they are set through their buffer
+			if (values[3] != -1 || values[2] < 0)
+				continue;
+
+			std::string name = GetResourceName(m_RendererID, GL_UNIFORM, i, nameBuffer);
+			m_UniformIndices[name] = (uint32_t)m_Uniforms.size();
+			m_Uniforms.push_back({ std::move(name), (GLenum)values[0], values[2], values[1] });
+		}
+
+		GLint attributeCount = 0;
+		glGetProgramInterfaceiv(m_RendererID, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &attributeCount);
+		glGetProgramInterfaceiv(m_RendererID, GL_PROGRAM_INPUT, GL_MAX_NAME_LENGTH, &maxNameLength);
+		nameBuffer.resize(std::max(maxNameLength, 1));
+
+		const GLenum attributeProperties[] = { GL_TYPE, GL_LOCATION };
+		for (GLint i = 0; i < attributeCount; i++)
+		{
+			GLint values[2];
+			glGetProgramResourceiv(m_RendererID, GL_PROGRAM_INPUT, i, 2, attributeProperties, 2, nullptr, values);
+
+			// Built-ins such as gl_VertexID have no location
+			if (values[1] < 0)
+				continue;
+
+			std::string name = GetResourceName(m_RendererID, GL_PROGRAM_INPUT, i, nameBuffer);
+			m_AttributeIndices[name] = (uint32_t)m_Attributes.size();
+			m_Attributes.push_back({ std::move(name), (GLenum)values[0], values[1] });
+		}
+	}
+
+	const ShaderUniform* Shader::FindUniform(const std::string& name) const
+	{
+		auto it = m_UniformIndices.find(name);
+		return it != m_UniformIndices.end() ? &m_Uniforms[it->second] : nullptr;
+	}
+
+	GLint Shader::GetUniformLocation(const std::string& name) const
+	{
+		const ShaderUniform* uniform = FindUniform(name);
+		if (!uniform)
+		{
+			LOG_WARN("Shader has no active uniform '{0}'", name);
+			return -1;
+		}
+		return uniform->Location;
+	}
+
+	GLint Shader::GetAttributeLocation(const std::string& name) const
+	{
+		auto it = m_AttributeIndices.find(name);
+		return it != m_AttributeIndices.end() ? m_Attributes[it->second].Location : -1;
+	}
+
+	void Shader::SetInt(GLint location, int value)
+	{
+		glProgramUniform1i(m_RendererID, location, value);
+	}
+
+	void Shader::SetIntArray(GLint location, const int* values, uint32_t count)
+	{
+		glProgramUniform1iv(m_RendererID, location, (GLsizei)count, values);
+	}
+
+	void Shader::SetFloat(GLint location, float value)
+	{
+		glProgramUniform1f(m_RendererID, location, value);
+	}
+
+	void Shader::SetFloat2(GLint location, const glm::vec2& value)
+	{
+		glProgramUniform2fv(m_RendererID, location, 1, glm::value_ptr(value));
+	}
+
+	void Shader::SetFloat3(GLint location, const glm::vec3& value)
+	{
+		glProgramUniform3fv(m_RendererID, location, 1, glm::value_ptr(value));
+	}
+
+	void Shader::SetFloat4(GLint location, const glm::vec4& value)
+	{
+		glProgramUniform4fv(m_RendererID, location, 1, glm::value_ptr(value));
+	}
+
+	void Shader::SetMat4(GLint location, const glm::mat4& value)
+	{
+		glProgramUniformMatrix4fv(m_RendererID, location, 1, GL_FALSE, glm::value_ptr(value));
 	}
 
 }
\ No newline at end of file
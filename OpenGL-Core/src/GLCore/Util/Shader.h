@@ -1,11 +1,52 @@
 #pragma once
 
+#include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "GLCore/Core/Core.h"
+#include "ShaderPreprocessor.h"
 
 namespace GLCore::Utils {
 
+	// Permutation keys for Shader::Get; each set bit is defined as the name in
+	// the comment, for the shaders that mention it
+	enum ShaderVariantFlags
+	{
+		ShaderVariantNone          = 0,
+		ShaderVariantTextured      = BIT(0), // TEXTURED
+		ShaderVariantTextureArray  = BIT(1), // TEXTURE_ARRAY
+		ShaderVariantVertexPulling = BIT(2)  // VERTEX_PULLING
+	};
+
+	// Active uniform outside of any block; arrays are listed once, without "[0]"
+	struct ShaderUniform
+	{
+		std::string Name;
+		GLenum Type;
+		GLint Location;
+		GLint Count;
+	};
+
+	struct ShaderVariantRequest
+	{
+		std::string Base;
+		uint32_t Flags = ShaderVariantNone;
+	};
+
+	struct ShaderAttribute
+	{
+		std::string Name;
+		GLenum Type;
+		GLint Location;
+	};
+
 	class Shader
 	{
 	public:
@@ -13,14 +54,121 @@ namespace GLCore::Utils {
 
 		GLuint GetRendererID() { return m_RendererID; }
 
-		static Shader* FromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+		// Reflected after every link; look locations up once and keep them,
+		// the setters below take them and never touch the bound program
+		GLint GetUniformLocation(const std::string& name) const;
+		GLint GetAttributeLocation(const std::string& name) const;
+		const ShaderUniform* FindUniform(const std::string& name) const;
+		const std::vector<ShaderUniform>& GetUniforms() const { return m_Uniforms; }
+		const std::vector<ShaderAttribute>& GetAttributes() const { return m_Attributes; }
+
+		// Location -1 (inactive or optimized out) is ignored by GL, as with glUniform*
+		void SetInt(GLint location, int value);
+		void SetIntArray(GLint location, const int* values, uint32_t count);
+		void SetFloat(GLint location, float value);
+		void SetFloat2(GLint location, const glm::vec2& value);
+		void SetFloat3(GLint location, const glm::vec3& value);
+		void SetFloat4(GLint location, const glm::vec4& value);
+		void SetMat4(GLint location, const glm::mat4& value);
+
+		// Empty for shaders built from source strings
+		const std::string& GetVertexPath() const { return m_VertexPath; }
+		const std::string& GetFragmentPath() const { return m_FragmentPath; }
+		const std::vector<ShaderDefine>& GetDefines() const { return m_Defines; }
+		// Files on disk that went into the program, includes too
+		const std::vector<std::string>& GetDependencies() const { return m_Dependencies; }
+
+		// Called after ShaderHotReload swapped in a new program: the renderer ID
+		// and locations may have changed and uniform values start out at zero
+		void SetReloadCallback(const std::function<void(Shader&)>& callback) { m_ReloadCallback = callback; }
+
+		// Sources go through ShaderPreprocessor (#include, defines) first
+		static Shader* FromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath, const std::vector<ShaderDefine>& defines = {});
+		static Shader* FromGLSLSource(const std::string& vertexSource, const std::string& fragmentSource);
+
+		// Timing of a batch build, see Warmup()
+		struct WarmupStatistics
+		{
+			uint32_t Programs = 0;
+			uint32_t CacheHits = 0;    // loaded from program binaries, nothing compiled
+			uint32_t Failures = 0;
+			float PreprocessMs = 0.0f; // reading and expanding the sources
+			float SubmitMs = 0.0f;     // handing every compile and link to the driver
+			float CollectMs = 0.0f;    // waiting for the results, reflection, cache writes
+			float TotalMs = 0.0f;
+			bool ParallelCompile = false;
+		};
+
+		// FromGLSLSource for many programs at once, built like Warmup(); the caller owns the shaders
+		static std::vector<Shader*> FromGLSLSources(const std::vector<std::pair<std::string, std::string>>& sources, WarmupStatistics* stats = nullptr);
+
+		// The program for base + ".vert.glsl" / ".frag.glsl" (virtual files or
+		// assets) with the ShaderVariantFlags defines. Built on first request and
+		// owned by the variant cache, every later call is one hash lookup.
+		// Requests whose expanded sources are identical share one program.
+		static Shader* Get(std::string_view base, uint32_t flags = ShaderVariantNone);
+		// Builds the variants that are not cached yet in one batch: every compile
+		// and link is submitted before any status is queried, so a driver with
+		// a threaded compiler (GL_KHR_parallel_shader_compile) works on all of
+		// them at once. Later Get() calls for them are plain lookups.
+		static WarmupStatistics Warmup(const std::vector<ShaderVariantRequest>& variants);
+		// Deletes every cached variant; pointers from Get() become invalid
+		static void ClearVariants();
+
+		struct VariantStatistics
+		{
+			uint32_t Requests = 0;
+			uint32_t Builds = 0;   // programs compiled (or loaded from the shader cache)
+			uint32_t Shared = 0;   // new keys that expanded to an existing program
+			uint32_t Variants = 0; // cached keys
+		};
+		static const VariantStatistics& GetVariantStats();
+		// Every Warmup() so far added up, startup included
+		static const WarmupStatistics& GetWarmupStats();
+
+		// GL_KHR_parallel_shader_compile (or the ARB version); the first call
+		// asks the driver for as many compiler threads as it likes
+		static bool IsParallelCompileSupported();
+		// False while a link submitted to the compiler threads is running; always true without the extension
+		static bool IsProgramReady(GLuint program);
 	private:
+		struct PendingProgram
+		{
+			GLuint VertexShader = 0;
+			GLuint FragmentShader = 0;
+			uint64_t CacheKey = 0;
+			bool Linking = false; // false when the program came from the shader cache
+		};
+
 		Shader() = default;
 
-		void LoadFromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
-		GLuint CompileShader(GLenum type, const std::string& source);
+		void LoadFromGLSLTextFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath, const std::vector<ShaderDefine>& defines);
+		void SetDependencies(const PreprocessedShader& vertex, const PreprocessedShader& fragment);
+		void LoadFromPreprocessed(const PreprocessedShader& vertex, const PreprocessedShader& fragment);
+		void LoadFromGLSLSource(std::string_view vertexSource, std::string_view fragmentSource);
+		// Returns true if the program came from the shader cache, otherwise pending needs collecting
+		bool SubmitGLSLSource(std::string_view vertexSource, std::string_view fragmentSource, PendingProgram& pending);
+		void CollectGLSLSource(const PendingProgram& pending);
+		GLuint CompileShader(GLenum type, std::string_view source);
+
+		static Shader* CreateVariant(std::string_view base, uint32_t flags, PreprocessedShader& vertex, PreprocessedShader& fragment);
+		static void BuildBatch(const std::vector<Shader*>& shaders, const std::vector<PreprocessedShader>& vertexSources,
+			const std::vector<PreprocessedShader>& fragmentSources, WarmupStatistics& stats);
+		void Reflect();
+		void ReplaceProgram(GLuint program, std::vector<std::string> dependencies);
 	private:
-		GLuint m_RendererID;
+		GLuint m_RendererID = 0;
+		std::string m_VertexPath, m_FragmentPath;
+		std::vector<ShaderDefine> m_Defines;
+		std::vector<std::string> m_Dependencies;
+		std::function<void(Shader&)> m_ReloadCallback;
+
+		std::vector<ShaderUniform> m_Uniforms;
+		std::vector<ShaderAttribute> m_Attributes;
+		std::unordered_map<std::string, uint32_t> m_UniformIndices;
+		std::unordered_map<std::string, uint32_t> m_AttributeIndices;
+
+		friend class ShaderHotReload;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,240 @@
+#include "glpch.h"
+#include "ShaderCache.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace GLCore::Utils {
+
+	struct ShaderCacheFileHeader
+	{
+		static constexpr uint32_t ExpectedMagic = 0x43534c47; // "GLSC"
+		static constexpr uint32_t CurrentVersion = 1;
+
+		uint32_t Magic = ExpectedMagic;
+		uint32_t Version = CurrentVersion;
+		uint64_t Key = 0;
+		uint32_t BinaryFormat = 0;
+		uint32_t BinarySize = 0;
+	};
+
+	struct ShaderCacheData
+	{
+		std::string Directory = "cache/shaders";
+		bool Enabled = true;
+
+		// Filled on first use, needs a context
+		bool DriverQueried = false;
+		std::string DriverID;
+		std::vector<GLint> BinaryFormats;
+
+		ShaderCache::Statistics Stats;
+	};
+
+	static ShaderCacheData s_CacheData;
+
+	static void QueryDriver()
+	{
+		if (s_CacheData.DriverQueried)
+			return;
+		s_CacheData.DriverQueried = true;
+
+		for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION })
+		{
+			const char* value = (const char*)glGetString(name);
+			s_CacheData.DriverID += value ? value : "";
+			s_CacheData.DriverID += '\n';
+		}
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		s_CacheData.BinaryFormats.resize(formatCount);
+		if (formatCount > 0)
+			glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, s_CacheData.BinaryFormats.data());
+		else
+			LOG_WARN("Driver has no program binary formats, shader cache disabled");
+	}
+
+	static bool IsUsable()
+	{
+		if (!s_CacheData.Enabled)
+			return false;
+		QueryDriver();
+		return !s_CacheData.BinaryFormats.empty();
+	}
+
+	static std::filesystem::path GetCachePath(uint64_t key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+		return std::filesystem::path(s_CacheData.Directory) / name;
+	}
+
+	// FNV-1a; each part is length prefixed so "ab" + "c" and "a" + "bc" differ
+	static void HashBytes(uint64_t& hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	static void HashPart(uint64_t& hash, std::string_view part)
+	{
+		uint64_t size = part.size();
+		HashBytes(hash, &size, sizeof(size));
+		HashBytes(hash, part.data(), part.size());
+	}
+
+	void ShaderCache::SetDirectory(const std::string& directory)
+	{
+		s_CacheData.Directory = directory;
+	}
+
+	const std::string& ShaderCache::GetDirectory()
+	{
+		return s_CacheData.Directory;
+	}
+
+	void ShaderCache::SetEnabled(bool enabled)
+	{
+		s_CacheData.Enabled = enabled;
+	}
+
+	bool ShaderCache::IsEnabled()
+	{
+		return s_CacheData.Enabled;
+	}
+
+	uint64_t ShaderCache::GetKey(std::initializer_list<std::string_view> sources, std::string_view defines)
+	{
+		QueryDriver();
+
+		uint64_t hash = 0xcbf29ce484222325ull;
+		HashBytes(hash, &ShaderCacheFileHeader::CurrentVersion, sizeof(ShaderCacheFileHeader::CurrentVersion));
+		HashPart(hash, s_CacheData.DriverID);
+		HashPart(hash, defines);
+		for (std::string_view source : sources)
+			HashPart(hash, source);
+		return hash;
+	}
+
+	GLuint ShaderCache::Load(uint64_t key)
+	{
+		if (!IsUsable())
+			return 0;
+
+		std::filesystem::path path = GetCachePath(key);
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+		{
+			s_CacheData.Stats.Misses++;
+			return 0;
+		}
+
+		ShaderCacheFileHeader header;
+		stream.read((char*)&header, sizeof(header));
+		bool valid = stream && header.Magic == ShaderCacheFileHeader::ExpectedMagic && header.Version == ShaderCacheFileHeader::CurrentVersion
+			&& header.Key == key && std::find(s_CacheData.BinaryFormats.begin(), s_CacheData.BinaryFormats.end(), (GLint)header.BinaryFormat) != s_CacheData.BinaryFormats.end();
+
+		// A corrupt size must not turn into a huge allocation
+		std::error_code sizeError;
+		uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+		valid = valid && !sizeError && header.BinarySize > 0 && header.BinarySize <= fileSize - sizeof(header);
+
+		std::vector<uint8_t> binary;
+		if (valid)
+		{
+			binary.resize(header.BinarySize);
+			stream.read((char*)binary.data(), binary.size());
+			valid = (bool)stream;
+		}
+		stream.close();
+
+		GLuint program = 0;
+		if (valid)
+		{
+			program = glCreateProgram();
+			glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size());
+
+			// Drivers may refuse binaries of another build even with the same version string
+			GLint isLinked = 0;
+			glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+			if (isLinked == GL_FALSE)
+			{
+				glDeleteProgram(program);
+				program = 0;
+			}
+		}
+
+		if (!program)
+		{
+			LOG_WARN("Discarding unusable shader cache entry '{0}'", path.string());
+			std::error_code error;
+			std::filesystem::remove(path, error);
+			s_CacheData.Stats.Rejected++;
+			return 0;
+		}
+
+		s_CacheData.Stats.Hits++;
+		return program;
+	}
+
+	void ShaderCache::Store(uint64_t key, GLuint program)
+	{
+		if (!IsUsable())
+			return;
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+			return;
+
+		ShaderCacheFileHeader header;
+		header.Key = key;
+		std::vector<uint8_t> binary(binarySize);
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data());
+		header.BinaryFormat = binaryFormat;
+		header.BinarySize = (uint32_t)binarySize;
+
+		std::error_code error;
+		std::filesystem::create_directories(s_CacheData.Directory, error);
+
+		// Written under a temporary name so a crash never leaves a truncated entry behind
+		std::filesystem::path path = GetCachePath(key);
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+			stream.write((const char*)&header, sizeof(header));
+			stream.write((const char*)binary.data(), header.BinarySize);
+			if (!stream)
+			{
+				LOG_WARN("Could not write shader cache entry '{0}'", path.string());
+				return;
+			}
+		}
+		std::filesystem::rename(temporaryPath, path, error);
+		if (!error)
+			s_CacheData.Stats.Stored++;
+	}
+
+	void ShaderCache::Clear()
+	{
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(s_CacheData.Directory, error))
+		{
+			if (entry.path().extension() == ".bin")
+				std::filesystem::remove(entry.path(), error);
+		}
+	}
+
+	const ShaderCache::Statistics& ShaderCache::GetStats()
+	{
+		return s_CacheData.Stats;
+	}
+
+}
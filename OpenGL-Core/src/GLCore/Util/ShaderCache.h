@@ -0,0 +1,47 @@
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+#include <glad/glad.h>
+
+namespace GLCore::Utils {
+
+	// On-disk cache of linked program binaries (glGetProgramBinary), one file
+	// per key in the cache directory. Keys cover the stage sources, the
+	// defines and the driver (vendor, renderer, version), so a driver update
+	// or an edited shader simply misses. A binary the driver refuses is
+	// deleted and the caller compiles from source as usual.
+	class ShaderCache
+	{
+	public:
+		// Defaults to "cache/shaders" below the working directory
+		static void SetDirectory(const std::string& directory);
+		static const std::string& GetDirectory();
+
+		// Also disabled when the driver reports no binary formats
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		static uint64_t GetKey(std::initializer_list<std::string_view> sources, std::string_view defines = {});
+
+		// A linked program, or 0 on a miss
+		static GLuint Load(uint64_t key);
+		// program must be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+		static void Store(uint64_t key, GLuint program);
+
+		// Deletes every cached binary
+		static void Clear();
+
+		struct Statistics
+		{
+			uint32_t Hits = 0;
+			uint32_t Misses = 0;
+			uint32_t Rejected = 0; // present but unusable, recompiled
+			uint32_t Stored = 0;
+		};
+		static const Statistics& GetStats();
+	};
+
+}
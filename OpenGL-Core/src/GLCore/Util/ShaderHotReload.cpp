@@ -0,0 +1,253 @@
+#include "glpch.h"
+#include "ShaderHotReload.h"
+
+#include "Shader.h"
+#include "ShaderCache.h"
+#include "ShaderPreprocessor.h"
+#include "Timer.h"
+
+#include "GLCore/Core/AssetPack.h"
+#include "GLCore/Core/FileWatcher.h"
+
+#include <filesystem>
+
+namespace GLCore::Utils {
+
+	struct PendingReload
+	{
+		Shader* Target = nullptr;
+		GLuint Program = 0;
+		GLuint VertexShader = 0;
+		GLuint FragmentShader = 0;
+		uint64_t CacheKey = 0;
+		std::vector<std::string> Dependencies;
+		Timer ReloadTimer;
+		uint32_t Frames = 0;
+	};
+
+	struct ShaderHotReloadData
+	{
+#ifdef GLCORE_DEBUG
+		bool Enabled = true;
+#else
+		bool Enabled = false;
+#endif
+		std::vector<Shader*> Shaders;
+		std::unique_ptr<FileWatcher> Watcher;
+		std::vector<PendingReload> Pending;
+
+		ShaderHotReload::Statistics Stats;
+	};
+
+	static ShaderHotReloadData s_ReloadData;
+
+	static void WatchShader(const Shader* shader)
+	{
+		for (const std::string& path : shader->GetDependencies())
+		{
+			std::string directory = std::filesystem::path(path).parent_path().string();
+			s_ReloadData.Watcher->Watch(directory.empty() ? "." : directory);
+		}
+	}
+
+	static void ReleaseReload(PendingReload& reload)
+	{
+		glDeleteShader(reload.VertexShader);
+		glDeleteShader(reload.FragmentShader);
+		if (reload.Program)
+			glDeleteProgram(reload.Program);
+	}
+
+	static void CancelReload(Shader* shader)
+	{
+		auto it = std::find_if(s_ReloadData.Pending.begin(), s_ReloadData.Pending.end(), [&](const PendingReload& reload) { return reload.Target == shader; });
+		if (it != s_ReloadData.Pending.end())
+		{
+			ReleaseReload(*it);
+			s_ReloadData.Pending.erase(it);
+		}
+	}
+
+	// Only queues the work; the status is not asked for until the driver reports completion
+	static GLuint BeginCompile(GLenum type, std::string_view source)
+	{
+		GLuint shader = glCreateShader(type);
+		const GLchar* sourceData = source.data();
+		const GLint sourceLength = (GLint)source.size();
+		glShaderSource(shader, 1, &sourceData, &sourceLength);
+		glCompileShader(shader);
+		return shader;
+	}
+
+	static void BeginReload(Shader* shader)
+	{
+		// Saving while the previous edit still compiles restarts it with the newer source
+		CancelReload(shader);
+
+		PreprocessedShader vertexSource = ShaderPreprocessor::ProcessFile(shader->GetVertexPath(), shader->GetDefines(), true);
+		PreprocessedShader fragmentSource = ShaderPreprocessor::ProcessFile(shader->GetFragmentPath(), shader->GetDefines(), true);
+		if (!vertexSource.Success || !fragmentSource.Success)
+		{
+			LOG_ERROR("Reloading '{0}' / '{1}' failed, keeping the previous program", shader->GetVertexPath(), shader->GetFragmentPath());
+			s_ReloadData.Stats.Failures++;
+			return;
+		}
+
+		PendingReload reload;
+		reload.Target = shader;
+		reload.CacheKey = ShaderCache::GetKey({ vertexSource.Source, fragmentSource.Source });
+		reload.VertexShader = BeginCompile(GL_VERTEX_SHADER, vertexSource.Source);
+		reload.FragmentShader = BeginCompile(GL_FRAGMENT_SHADER, fragmentSource.Source);
+
+		// An edit may have added or removed includes
+		reload.Dependencies = vertexSource.Dependencies;
+		for (const std::string& dependency : fragmentSource.Dependencies)
+		{
+			if (std::find(reload.Dependencies.begin(), reload.Dependencies.end(), dependency) == reload.Dependencies.end())
+				reload.Dependencies.push_back(dependency);
+		}
+
+		reload.Program = glCreateProgram();
+		glAttachShader(reload.Program, reload.VertexShader);
+		glAttachShader(reload.Program, reload.FragmentShader);
+		glProgramParameteri(reload.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(reload.Program);
+
+		s_ReloadData.Pending.push_back(std::move(reload));
+	}
+
+	static void ReportShaderLog(GLuint shader, const std::string& path)
+	{
+		GLint isCompiled = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+		if (isCompiled == GL_TRUE)
+			return;
+
+		GLint maxLength = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+		std::vector<GLchar> infoLog(std::max(maxLength, 1));
+		glGetShaderInfoLog(shader, (GLsizei)infoLog.size(), nullptr, infoLog.data());
+		LOG_ERROR("{0}:\n{1}", path, infoLog.data());
+	}
+
+	static bool CheckLinkStatus(const PendingReload& reload)
+	{
+		GLint isLinked = 0;
+		glGetProgramiv(reload.Program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_TRUE)
+			return true;
+
+		const Shader* shader = reload.Target;
+		ReportShaderLog(reload.VertexShader, shader->GetVertexPath());
+		ReportShaderLog(reload.FragmentShader, shader->GetFragmentPath());
+
+		GLint maxLength = 0;
+		glGetProgramiv(reload.Program, GL_INFO_LOG_LENGTH, &maxLength);
+		std::vector<GLchar> infoLog(std::max(maxLength, 1));
+		glGetProgramInfoLog(reload.Program, (GLsizei)infoLog.size(), nullptr, infoLog.data());
+		LOG_ERROR("Reloading '{0}' / '{1}' failed, keeping the previous program\n{2}", shader->GetVertexPath(), shader->GetFragmentPath(), infoLog.data());
+		return false;
+	}
+
+	void ShaderHotReload::SetEnabled(bool enabled)
+	{
+		s_ReloadData.Enabled = enabled;
+		if (!enabled)
+			Shutdown();
+	}
+
+	bool ShaderHotReload::IsEnabled()
+	{
+		return s_ReloadData.Enabled;
+	}
+
+	void ShaderHotReload::Register(Shader* shader)
+	{
+		s_ReloadData.Shaders.push_back(shader);
+		if (s_ReloadData.Watcher)
+			WatchShader(shader);
+	}
+
+	void ShaderHotReload::Unregister(Shader* shader)
+	{
+		CancelReload(shader);
+		s_ReloadData.Shaders.erase(std::remove(s_ReloadData.Shaders.begin(), s_ReloadData.Shaders.end(), shader), s_ReloadData.Shaders.end());
+	}
+
+	void ShaderHotReload::Update()
+	{
+		if (!s_ReloadData.Enabled)
+			return;
+
+		if (!s_ReloadData.Watcher)
+		{
+			if (!Shader::IsParallelCompileSupported())
+				LOG_INFO("No parallel shader compile extension, reloaded shaders are collected on the next frame");
+			s_ReloadData.Watcher = std::make_unique<FileWatcher>();
+			for (Shader* shader : s_ReloadData.Shaders)
+				WatchShader(shader);
+		}
+
+		for (const std::string& path : s_ReloadData.Watcher->Poll())
+		{
+			for (Shader* shader : s_ReloadData.Shaders)
+			{
+				const std::vector<std::string>& dependencies = shader->GetDependencies();
+				if (std::find(dependencies.begin(), dependencies.end(), path) != dependencies.end())
+					BeginReload(shader);
+			}
+		}
+
+		std::vector<PendingReload> pending = std::move(s_ReloadData.Pending);
+		s_ReloadData.Pending.clear();
+		for (PendingReload& reload : pending)
+		{
+			// Without the extension the first status query waits for the compile, so a
+			// reload started this frame is left for the next one instead of stalling it
+			bool started = reload.Frames++ == 0;
+			if ((started && !Shader::IsParallelCompileSupported()) || !Shader::IsProgramReady(reload.Program))
+			{
+				s_ReloadData.Pending.push_back(std::move(reload));
+				continue;
+			}
+
+			Shader* shader = reload.Target;
+			if (CheckLinkStatus(reload))
+			{
+				glDetachShader(reload.Program, reload.VertexShader);
+				glDetachShader(reload.Program, reload.FragmentShader);
+				ShaderCache::Store(reload.CacheKey, reload.Program);
+
+				shader->ReplaceProgram(reload.Program, std::move(reload.Dependencies));
+				reload.Program = 0;
+				WatchShader(shader);
+
+				s_ReloadData.Stats.Reloads++;
+				s_ReloadData.Stats.LastReloadMs = reload.ReloadTimer.ElapsedMillis();
+				s_ReloadData.Stats.LastReloadFrames = reload.Frames;
+				LOG_INFO("Reloaded '{0}' / '{1}' ({2:.1f} ms)", shader->GetVertexPath(), shader->GetFragmentPath(), s_ReloadData.Stats.LastReloadMs);
+			}
+			else
+			{
+				s_ReloadData.Stats.Failures++;
+			}
+			ReleaseReload(reload);
+		}
+		s_ReloadData.Stats.Pending = (uint32_t)s_ReloadData.Pending.size();
+	}
+
+	void ShaderHotReload::Shutdown()
+	{
+		for (PendingReload& reload : s_ReloadData.Pending)
+			ReleaseReload(reload);
+		s_ReloadData.Pending.clear();
+		s_ReloadData.Stats.Pending = 0;
+		s_ReloadData.Watcher.reset();
+	}
+
+	const ShaderHotReload::Statistics& ShaderHotReload::GetStats()
+	{
+		return s_ReloadData.Stats;
+	}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GLCore::Utils {
+
+	class Shader;
+
+	// Recompiles shaders loaded from files (Shader::FromGLSLTextFiles and
+	// Shader::Get) when one of their files, includes too, is saved. The
+	// loose files are watched (and read, even with an asset pack mounted)
+	// and the new program is compiled and linked in the background: with
+	// GL_KHR_parallel_shader_compile the driver does it on its own threads
+	// and Update() only polls GL_COMPLETION_STATUS_KHR, without it the result
+	// is collected on the next frame. A program that links replaces the old
+	// one in place; if it fails the log is reported and the old program keeps
+	// running.
+	//
+	// Enabled by default in Debug builds.
+	class ShaderHotReload
+	{
+	public:
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// Picks up changes and finishes reloads; called by Application once per frame
+		static void Update();
+		// Drops the watcher and any reload still in flight
+		static void Shutdown();
+
+		struct Statistics
+		{
+			uint32_t Reloads = 0;
+			uint32_t Failures = 0;   // old program kept
+			uint32_t Pending = 0;    // compiling right now
+			float LastReloadMs = 0.0f; // from the file change to the swap
+			uint32_t LastReloadFrames = 0;
+		};
+		static const Statistics& GetStats();
+	private:
+		static void Register(Shader* shader);
+		static void Unregister(Shader* shader);
+
+		friend class Shader;
+	};
+
+}
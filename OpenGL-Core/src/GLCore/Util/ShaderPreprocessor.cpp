@@ -0,0 +1,244 @@
+#include "glpch.h"
+#include "ShaderPreprocessor.h"
+
+#include "GLCore/Core/AssetPack.h"
+
+#include <filesystem>
+
+namespace GLCore::Utils {
+
+	static const uint32_t s_MaxIncludeDepth = 32;
+
+	static std::unordered_map<std::string, std::string> s_VirtualFiles;
+
+	struct PreprocessContext
+	{
+		PreprocessedShader& Result;
+		bool LooseFiles = false;
+		std::unordered_set<std::string> IncludedOnce;
+
+		// Where the defines go: after the top level #version line
+		size_t DefinesOffset = 0;
+		uint32_t DefinesLine = 1;
+	};
+
+	static bool IsIdentifierChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	static std::string_view TrimLeft(std::string_view text)
+	{
+		size_t start = text.find_first_not_of(" \t");
+		return start == std::string_view::npos ? std::string_view() : text.substr(start);
+	}
+
+	// Matches "#<directive>" with optional whitespace after the '#', returns the rest of the line
+	static bool MatchDirective(std::string_view line, std::string_view directive, std::string_view& arguments)
+	{
+		line = TrimLeft(line);
+		if (line.empty() || line[0] != '#')
+			return false;
+
+		line = TrimLeft(line.substr(1));
+		if (line.compare(0, directive.size(), directive) != 0)
+			return false;
+		if (line.size() > directive.size() && IsIdentifierChar(line[directive.size()]))
+			return false;
+
+		arguments = TrimLeft(line.substr(directive.size()));
+		return true;
+	}
+
+	static bool ContainsIdentifier(const std::string& source, const std::string& name)
+	{
+		for (size_t position = source.find(name); position != std::string::npos; position = source.find(name, position + 1))
+		{
+			bool startsWord = position == 0 || !IsIdentifierChar(source[position - 1]);
+			bool endsWord = position + name.size() == source.size() || !IsIdentifierChar(source[position + name.size()]);
+			if (startsWord && endsWord)
+				return true;
+		}
+		return false;
+	}
+
+	// Virtual files first, then the pack or the loose file
+	static bool ReadSource(const std::string& name, bool looseFiles, std::string& source, bool& isVirtual)
+	{
+		auto it = s_VirtualFiles.find(name);
+		isVirtual = it != s_VirtualFiles.end();
+		if (isVirtual)
+		{
+			source = it->second;
+			return true;
+		}
+
+		AssetData data = looseFiles ? AssetPack::ReadFile(name) : AssetPack::Read(name);
+		if (!data)
+			return false;
+		source = std::string(data.GetString());
+		return true;
+	}
+
+	static void Expand(PreprocessContext& context, std::string_view source, const std::string& name, uint32_t depth);
+
+	static bool ExpandFile(PreprocessContext& context, const std::string& name, uint32_t depth)
+	{
+		std::string source;
+		bool isVirtual = false;
+		if (!ReadSource(name, context.LooseFiles, source, isVirtual))
+			return false;
+
+		context.Result.Files.push_back(name);
+		if (!isVirtual)
+			context.Result.Dependencies.push_back(name);
+		Expand(context, source, name, depth);
+		return true;
+	}
+
+	static void Include(PreprocessContext& context, std::string_view arguments, const std::string& includer, uint32_t line, uint32_t depth)
+	{
+		char close = arguments.empty() ? 0 : arguments[0] == '<' ? '>' : arguments[0] == '"' ? '"' : 0;
+		size_t end = close ? arguments.find(close, 1) : std::string_view::npos;
+		if (end == std::string_view::npos)
+		{
+			LOG_ERROR("{0}({1}): malformed #include", includer, line);
+			context.Result.Success = false;
+			return;
+		}
+
+		std::string name(arguments.substr(1, end - 1));
+		if (depth >= s_MaxIncludeDepth)
+		{
+			LOG_ERROR("{0}({1}): #include '{2}' nested too deeply, missing #pragma once?", includer, line, name);
+			context.Result.Success = false;
+			return;
+		}
+
+		// Relative to the including file first, then relative to the working directory (or a virtual name)
+		std::vector<std::string> candidates;
+		std::string directory = std::filesystem::path(includer).parent_path().generic_string();
+		if (!directory.empty())
+			candidates.push_back(AssetPack::NormalizePath(directory + "/" + name));
+		candidates.push_back(AssetPack::NormalizePath(name));
+
+		uint32_t fileIndex = (uint32_t)context.Result.Files.size();
+		for (const std::string& candidate : candidates)
+		{
+			if (context.IncludedOnce.count(candidate))
+				return;
+
+			size_t rollback = context.Result.Source.size();
+			context.Result.Source += "#line 1 " + std::to_string(fileIndex) + "\n";
+			if (ExpandFile(context, candidate, depth + 1))
+				return;
+			context.Result.Source.resize(rollback);
+		}
+
+		LOG_ERROR("{0}({1}): could not include '{2}'", includer, line, name);
+		context.Result.Success = false;
+	}
+
+	static void Expand(PreprocessContext& context, std::string_view source, const std::string& name, uint32_t depth)
+	{
+		uint32_t fileIndex = (uint32_t)context.Result.Files.size() - 1;
+		uint32_t lineNumber = 0;
+		size_t lineStart = 0;
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string_view::npos)
+				lineEnd = source.size();
+			std::string_view line = source.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+			lineNumber++;
+
+			std::string_view arguments;
+			if (MatchDirective(line, "include", arguments))
+			{
+				Include(context, arguments, name, lineNumber, depth);
+				// Back in this file, on the line after the #include
+				context.Result.Source += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+				continue;
+			}
+
+			if (MatchDirective(line, "pragma", arguments) && arguments.compare(0, 4, "once") == 0)
+			{
+				context.IncludedOnce.insert(name);
+				context.Result.Source += "\n";
+				continue;
+			}
+
+			context.Result.Source += line;
+			context.Result.Source += '\n';
+
+			if (depth == 0 && MatchDirective(line, "version", arguments))
+			{
+				context.DefinesOffset = context.Result.Source.size();
+				context.DefinesLine = lineNumber + 1;
+			}
+		}
+	}
+
+	static void InsertDefines(PreprocessContext& context, const std::vector<ShaderDefine>& defines)
+	{
+		std::string block;
+		for (const ShaderDefine& define : defines)
+		{
+			if (!ContainsIdentifier(context.Result.Source, define.Name))
+				continue;
+
+			block += "#define " + define.Name;
+			if (!define.Value.empty())
+				block += " " + define.Value;
+			block += '\n';
+		}
+
+		if (block.empty())
+			return;
+
+		block += "#line " + std::to_string(context.DefinesLine) + " 0\n";
+		context.Result.Source.insert(context.DefinesOffset, block);
+	}
+
+	PreprocessedShader ShaderPreprocessor::ProcessFile(const std::string& path, const std::vector<ShaderDefine>& defines, bool looseFiles)
+	{
+		PreprocessedShader result;
+		PreprocessContext context{ result, looseFiles };
+
+		std::string name = AssetPack::NormalizePath(path);
+		if (!ExpandFile(context, name, 0))
+		{
+			LOG_ERROR("Could not open file '{0}'", path);
+			result.Success = false;
+			return result;
+		}
+
+		InsertDefines(context, defines);
+		return result;
+	}
+
+	PreprocessedShader ShaderPreprocessor::ProcessSource(std::string_view source, const std::vector<ShaderDefine>& defines)
+	{
+		PreprocessedShader result;
+		PreprocessContext context{ result };
+
+		const std::string name = "<source>";
+		result.Files.push_back(name);
+		Expand(context, source, name, 0);
+
+		InsertDefines(context, defines);
+		return result;
+	}
+
+	void ShaderPreprocessor::AddVirtualFile(const std::string& name, const std::string& source)
+	{
+		s_VirtualFiles[AssetPack::NormalizePath(name)] = source;
+	}
+
+	bool ShaderPreprocessor::IsVirtualFile(const std::string& name)
+	{
+		return s_VirtualFiles.count(AssetPack::NormalizePath(name)) != 0;
+	}
+
+}
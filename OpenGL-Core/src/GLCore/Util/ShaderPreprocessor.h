@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GLCore::Utils {
+
+	struct ShaderDefine
+	{
+		std::string Name;
+		std::string Value; // empty for a plain #define NAME
+	};
+
+	struct PreprocessedShader
+	{
+		std::string Source;
+		// Every file that went in; index i is source string i in the #line
+		// directives, which is the number compile logs report ("1(12)")
+		std::vector<std::string> Files;
+		// The subset of Files read from disk (or the asset pack), for hot reload
+		std::vector<std::string> Dependencies;
+		bool Success = true;
+	};
+
+	// Minimal GLSL preprocessor run before every compile:
+	//
+	//   #include "file.glsl"  relative to the including file, then as given;
+	//                         <file.glsl> is the same. Virtual files (built-in
+	//                         sources registered by the engine) win over disk.
+	//   #pragma once          includes a file at most once per shader
+	//
+	// Includes are expanded wherever they appear, #if blocks are left to the
+	// GLSL compiler. Defines are inserted right after #version, but only the
+	// ones whose name occurs in the expanded source, so flags a shader does
+	// not use give identical text and Shader::Get can share the program.
+	class ShaderPreprocessor
+	{
+	public:
+		// looseFiles reads from disk even with an asset pack mounted (hot reload)
+		static PreprocessedShader ProcessFile(const std::string& path, const std::vector<ShaderDefine>& defines = {}, bool looseFiles = false);
+		static PreprocessedShader ProcessSource(std::string_view source, const std::vector<ShaderDefine>& defines = {});
+
+		// Makes an in-memory source includable (and loadable) under name
+		static void AddVirtualFile(const std::string& name, const std::string& source);
+		static bool IsVirtualFile(const std::string& name);
+	};
+
+}
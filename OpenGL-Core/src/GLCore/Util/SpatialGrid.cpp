@@ -0,0 +1,131 @@
+#include "glpch.h"
+#include "SpatialGrid.h"
+
+namespace GLCore::Utils {
+
+	SpatialGrid::SpatialGrid(const SpatialGridSpecification& spec)
+		: m_Specification(spec)
+	{
+		GLCORE_ASSERT(spec.CellSize > 0.0f, "SpatialGrid cell size must be positive!");
+
+		m_InverseCellSize = 1.0f / spec.CellSize;
+		glm::vec2 extent = spec.WorldMax - spec.WorldMin;
+		m_CellsX = std::max(1u, (uint32_t)std::ceil(extent.x * m_InverseCellSize));
+		m_CellsY = std::max(1u, (uint32_t)std::ceil(extent.y * m_InverseCellSize));
+		m_Cells.resize((size_t)m_CellsX * m_CellsY);
+	}
+
+	uint32_t SpatialGrid::GetCellIndex(const glm::vec2& position) const
+	{
+		glm::vec2 local = (position - m_Specification.WorldMin) * m_InverseCellSize;
+		int32_t x = std::clamp((int32_t)std::floor(local.x), 0, (int32_t)m_CellsX - 1);
+		int32_t y = std::clamp((int32_t)std::floor(local.y), 0, (int32_t)m_CellsY - 1);
+		return (uint32_t)y * m_CellsX + (uint32_t)x;
+	}
+
+	void SpatialGrid::AddToCell(uint32_t handle, uint32_t cell)
+	{
+		std::vector<uint32_t>& contents = m_Cells[cell];
+		m_Objects[handle].Cell = cell;
+		m_Objects[handle].IndexInCell = (uint32_t)contents.size();
+		contents.push_back(handle);
+	}
+
+	void SpatialGrid::RemoveFromCell(uint32_t handle)
+	{
+		// Swap with the last entry so removal is O(1)
+		const Object& object = m_Objects[handle];
+		std::vector<uint32_t>& contents = m_Cells[object.Cell];
+		uint32_t last = contents.back();
+		contents[object.IndexInCell] = last;
+		m_Objects[last].IndexInCell = object.IndexInCell;
+		contents.pop_back();
+	}
+
+	uint32_t SpatialGrid::Insert(const glm::vec2& center, const glm::vec2& halfSize, uint32_t userData)
+	{
+		uint32_t handle;
+		if (m_FreeList != InvalidHandle)
+		{
+			handle = m_FreeList;
+			m_FreeList = m_Objects[handle].IndexInCell;
+		}
+		else
+		{
+			handle = (uint32_t)m_Objects.size();
+			m_Objects.emplace_back();
+		}
+
+		Object& object = m_Objects[handle];
+		object.Min = center - halfSize;
+		object.Max = center + halfSize;
+		object.UserData = userData;
+		m_MaxHalfSize = glm::max(m_MaxHalfSize, halfSize);
+
+		AddToCell(handle, GetCellIndex(center));
+		m_Count++;
+		return handle;
+	}
+
+	void SpatialGrid::Move(uint32_t handle, const glm::vec2& center, const glm::vec2& halfSize)
+	{
+		Object& object = m_Objects[handle];
+		GLCORE_ASSERT(object.Cell != InvalidHandle, "Moving a removed SpatialGrid object!");
+
+		object.Min = center - halfSize;
+		object.Max = center + halfSize;
+		m_MaxHalfSize = glm::max(m_MaxHalfSize, halfSize);
+
+		uint32_t cell = GetCellIndex(center);
+		if (cell != object.Cell)
+		{
+			RemoveFromCell(handle);
+			AddToCell(handle, cell);
+		}
+	}
+
+	void SpatialGrid::Remove(uint32_t handle)
+	{
+		Object& object = m_Objects[handle];
+		GLCORE_ASSERT(object.Cell != InvalidHandle, "Removing a SpatialGrid object twice!");
+
+		RemoveFromCell(handle);
+		object.Cell = InvalidHandle;
+		object.IndexInCell = m_FreeList;
+		m_FreeList = handle;
+		m_Count--;
+	}
+
+	void SpatialGrid::Clear()
+	{
+		for (std::vector<uint32_t>& contents : m_Cells)
+			contents.clear();
+		m_Objects.clear();
+		m_FreeList = InvalidHandle;
+		m_Count = 0;
+		m_MaxHalfSize = { 0.0f, 0.0f };
+	}
+
+	void SpatialGrid::Query(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t>& outUserData) const
+	{
+		// An object can overhang its cell by up to the largest half size
+		uint32_t first = GetCellIndex(min - m_MaxHalfSize);
+		uint32_t last = GetCellIndex(max + m_MaxHalfSize);
+		uint32_t firstX = first % m_CellsX, firstY = first / m_CellsX;
+		uint32_t lastX = last % m_CellsX, lastY = last / m_CellsX;
+
+		for (uint32_t y = firstY; y <= lastY; y++)
+		{
+			for (uint32_t x = firstX; x <= lastX; x++)
+			{
+				for (uint32_t handle : m_Cells[(size_t)y * m_CellsX + x])
+				{
+					const Object& object = m_Objects[handle];
+					if (object.Max.x >= min.x && object.Min.x <= max.x && object.Max.y >= min.y && object.Min.y <= max.y)
+						outUserData.push_back(object.UserData);
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace GLCore::Utils {
+
+	struct SpatialGridSpecification
+	{
+		glm::vec2 WorldMin = { -1024.0f, -1024.0f };
+		glm::vec2 WorldMax = { 1024.0f, 1024.0f }; // objects outside land in the border cells
+		float CellSize = 16.0f;                     // a few times the typical object size works well
+	};
+
+	// Loose uniform grid over axis aligned boxes. Each object lives in the one
+	// cell that holds its center, so insert/move/remove touch a single cell;
+	// queries grow the search area by the largest half size ever inserted and
+	// then test the exact boxes.
+	class SpatialGrid
+	{
+	public:
+		static const uint32_t InvalidHandle = 0xffffffff;
+
+		SpatialGrid(const SpatialGridSpecification& spec = SpatialGridSpecification());
+
+		// Returns a handle that stays valid until the object is removed
+		uint32_t Insert(const glm::vec2& center, const glm::vec2& halfSize, uint32_t userData);
+		void Move(uint32_t handle, const glm::vec2& center, const glm::vec2& halfSize);
+		void Remove(uint32_t handle);
+		void Clear();
+
+		// Appends the user data of every object overlapping [min, max]
+		void Query(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t>& outUserData) const;
+
+		uint32_t GetUserData(uint32_t handle) const { return m_Objects[handle].UserData; }
+		uint32_t GetCount() const { return m_Count; }
+		const SpatialGridSpecification& GetSpecification() const { return m_Specification; }
+	private:
+		struct Object
+		{
+			glm::vec2 Min, Max;
+			uint32_t UserData;
+			uint32_t Cell;        // InvalidHandle when the slot is free
+			uint32_t IndexInCell; // next free slot while free
+		};
+
+		uint32_t GetCellIndex(const glm::vec2& position) const;
+		void AddToCell(uint32_t handle, uint32_t cell);
+		void RemoveFromCell(uint32_t handle);
+	private:
+		SpatialGridSpecification m_Specification;
+		uint32_t m_CellsX, m_CellsY;
+		float m_InverseCellSize;
+		glm::vec2 m_MaxHalfSize = { 0.0f, 0.0f };
+
+		std::vector<Object> m_Objects;
+		std::vector<std::vector<uint32_t>> m_Cells;
+		uint32_t m_FreeList = InvalidHandle;
+		uint32_t m_Count = 0;
+	};
+
+}
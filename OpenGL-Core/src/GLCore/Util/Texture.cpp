@@ -0,0 +1,202 @@
+#include "glpch.h"
+#include "Texture.h"
+
+#include "GLCore/Core/AssetPack.h"
+
+#include <stb_image.h>
+
+namespace GLCore::Utils {
+
+	Image Image::FromFile(const std::string& path, uint32_t channels)
+	{
+		Image image;
+
+		AssetData data = AssetPack::Read(path);
+		if (!data)
+		{
+			LOG_ERROR("Could not open image '{0}'", path);
+			return image;
+		}
+
+		int w, h, bits;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* pixels = stbi_load_from_memory(data.GetData(), (int)data.GetSize(), &w, &h, &bits, (int)channels);
+		if (!pixels)
+		{
+			LOG_ERROR("Could not load image '{0}': {1}", path, stbi_failure_reason());
+			return image;
+		}
+
+		image.Width = (uint32_t)w;
+		image.Height = (uint32_t)h;
+		image.Channels = channels;
+		image.Pixels.assign(pixels, pixels + (size_t)w * h * channels);
+
+		stbi_image_free(pixels);
+		return image;
+	}
+
+	Image Image::Resized(uint32_t width, uint32_t height) const
+	{
+		Image image;
+		image.Width = width;
+		image.Height = height;
+		image.Channels = Channels;
+		image.Pixels.resize((size_t)width * height * Channels);
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			// Source rows covered by this row, at least one when upscaling
+			uint32_t y0 = (uint32_t)((uint64_t)y * Height / height);
+			uint32_t y1 = std::max(y0 + 1, (uint32_t)((uint64_t)(y + 1) * Height / height));
+
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint32_t x0 = (uint32_t)((uint64_t)x * Width / width);
+				uint32_t x1 = std::max(x0 + 1, (uint32_t)((uint64_t)(x + 1) * Width / width));
+
+				uint32_t sum[4] = {};
+				for (uint32_t sy = y0; sy < y1; sy++)
+				{
+					const uint8_t* source = &Pixels[((size_t)sy * Width + x0) * Channels];
+					for (uint32_t sx = x0; sx < x1; sx++)
+						for (uint32_t c = 0; c < Channels; c++)
+							sum[c] += *source++;
+				}
+
+				uint32_t count = (y1 - y0) * (x1 - x0);
+				uint8_t* target = &image.Pixels[((size_t)y * width + x) * Channels];
+				for (uint32_t c = 0; c < Channels; c++)
+					target[c] = (uint8_t)((sum[c] + count / 2) / count);
+			}
+		}
+		return image;
+	}
+
+	GLuint LoadTexture(const std::string& path)
+	{
+		AssetData data = AssetPack::Read(path);
+
+		int w, h, bits;
+
+		stbi_set_flip_vertically_on_load(1);
+		auto* pixels = stbi_load_from_memory(data.GetData(), (int)data.GetSize(), &w, &h, &bits, STBI_rgb);
+
+		GLuint textureID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+		glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureStorage2D(textureID, 1, GL_RGB8, w, h);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(textureID, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+
+		stbi_image_free(pixels);
+		return textureID;
+	}
+
+	static GLuint CreateTextureArray(uint32_t width, uint32_t height, uint32_t layers)
+	{
+		GLint maxLayers = 0;
+		glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+		GLCORE_ASSERT(layers <= (uint32_t)maxLayers, "Too many texture array layers!");
+
+		GLuint textureID;
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &textureID);
+		glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureStorage3D(textureID, 1, GL_RGBA8, width, height, layers);
+		return textureID;
+	}
+
+	GLuint LoadTextureArray(const std::vector<std::string>& paths, uint32_t width, uint32_t height)
+	{
+		std::vector<Image> images;
+		images.reserve(paths.size());
+		for (const std::string& path : paths)
+			images.push_back(Image::FromFile(path, 4));
+
+		std::vector<const Image*> layers;
+		for (const Image& image : images)
+			layers.push_back(&image);
+		return LoadTextureArrayFromImages(layers, width, height);
+	}
+
+	GLuint LoadTextureArrayFromImages(const std::vector<const Image*>& images, uint32_t width, uint32_t height)
+	{
+		GLCORE_ASSERT(!images.empty(), "Texture array needs at least one layer!");
+
+		if ((width == 0 || height == 0) && images[0])
+		{
+			width = images[0]->Width;
+			height = images[0]->Height;
+		}
+		if (width == 0 || height == 0)
+			return 0;
+
+		GLuint textureID = CreateTextureArray(width, height, (uint32_t)images.size());
+
+		// Missing images leave their layer transparent instead of undefined
+		uint32_t clearColor = 0;
+		glClearTexImage(textureID, 0, GL_RGBA, GL_UNSIGNED_BYTE, &clearColor);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (uint32_t layer = 0; layer < (uint32_t)images.size(); layer++)
+		{
+			const Image* image = images[layer];
+			if (!image || !image->IsValid())
+				continue;
+			GLCORE_ASSERT(image->Channels == 4, "Texture array layers must be RGBA!");
+
+			Image resized;
+			if (image->Width != width || image->Height != height)
+			{
+				LOG_WARN("Texture array layer {0} is {1}x{2}, resizing to {3}x{4}", layer, image->Width, image->Height, width, height);
+				resized = image->Resized(width, height);
+				image = &resized;
+			}
+
+			glTextureSubImage3D(textureID, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, image->Pixels.data());
+		}
+		return textureID;
+	}
+
+	GLuint LoadTextureArrayFromSheet(const std::string& path, uint32_t tileWidth, uint32_t tileHeight, uint32_t* outLayerCount)
+	{
+		Image sheet = Image::FromFile(path, 4);
+		uint32_t columns = tileWidth ? sheet.Width / tileWidth : 0;
+		uint32_t rows = tileHeight ? sheet.Height / tileHeight : 0;
+		if (outLayerCount)
+			*outLayerCount = columns * rows;
+		if (columns == 0 || rows == 0)
+		{
+			LOG_ERROR("Sheet '{0}' has no {1}x{2} tiles", path, tileWidth, tileHeight);
+			return 0;
+		}
+
+		GLuint textureID = CreateTextureArray(tileWidth, tileHeight, columns * rows);
+
+		// Tiles are uploaded straight out of the sheet, the unpack state selects the rectangle
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, sheet.Width);
+		for (uint32_t row = 0; row < rows; row++)
+		{
+			for (uint32_t column = 0; column < columns; column++)
+			{
+				// The image is stored bottom row first, layer 0 is the top left tile
+				glPixelStorei(GL_UNPACK_SKIP_PIXELS, column * tileWidth);
+				glPixelStorei(GL_UNPACK_SKIP_ROWS, sheet.Height - (row + 1) * tileHeight);
+				glTextureSubImage3D(textureID, 0, 0, 0, row * columns + column, tileWidth, tileHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, sheet.Pixels.data());
+			}
+		}
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+
+		return textureID;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace GLCore::Utils {
+
+	// Decoded pixels in CPU memory, bottom row first to match GL texture coordinates
+	struct Image
+	{
+		uint32_t Width = 0, Height = 0;
+		uint32_t Channels = 0;
+		std::vector<uint8_t> Pixels;
+
+		bool IsValid() const { return !Pixels.empty(); }
+
+		// Box filtered copy, for fitting odd-sized images into a texture array
+		Image Resized(uint32_t width, uint32_t height) const;
+
+		static Image FromFile(const std::string& path, uint32_t channels = 4);
+	};
+
+	GLuint LoadTexture(const std::string& path);
+
+	// GL_TEXTURE_2D_ARRAY (RGBA8) with one layer per image, in order. Layers are
+	// width x height, taken from the first image when 0; images of another size
+	// are resized to fit.
+	GLuint LoadTextureArray(const std::vector<std::string>& paths, uint32_t width = 0, uint32_t height = 0);
+	// Same for images that are already decoded; null or invalid images leave their layer transparent
+	GLuint LoadTextureArrayFromImages(const std::vector<const Image*>& images, uint32_t width = 0, uint32_t height = 0);
+	// Splits a tile or character sheet into tileWidth x tileHeight layers, row by
+	// row starting at the top left. Tiles in their own layers cannot bleed into
+	// their neighbours when filtered.
+	GLuint LoadTextureArrayFromSheet(const std::string& path, uint32_t tileWidth, uint32_t tileHeight, uint32_t* outLayerCount = nullptr);
+
+}
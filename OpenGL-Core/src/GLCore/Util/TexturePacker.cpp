@@ -0,0 +1,177 @@
+#include "glpch.h"
+#include "TexturePacker.h"
+
+#include "Timer.h"
+
+namespace GLCore::Utils {
+
+	static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	TexturePacker::TexturePacker(const TexturePackerSpecification& spec)
+		: m_Specification(spec)
+	{
+		if (m_Specification.Alignment == 0)
+			m_Specification.Alignment = 1;
+	}
+
+	bool TexturePacker::Pack(std::vector<PackRect>& rects)
+	{
+		Timer timer;
+
+		m_Pages.clear();
+		m_Stats = TexturePackerStats();
+
+		// The gutter before the image is rounded up so the image itself, not its slot, starts aligned
+		const uint32_t lead = AlignUp(m_Specification.Gutter, m_Specification.Alignment);
+		const uint32_t border = lead + m_Specification.Gutter + m_Specification.Padding;
+
+		// Tall rects first keeps the skyline flat
+		std::vector<uint32_t> order(rects.size());
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+		{
+			if (rects[a].Height != rects[b].Height)
+				return rects[a].Height > rects[b].Height;
+			return rects[a].Width > rects[b].Width;
+		});
+
+		uint64_t usedArea = 0;
+		for (uint32_t index : order)
+		{
+			PackRect& rect = rects[index];
+			rect.Page = PackRect::InvalidPage;
+
+			uint32_t width = AlignUp(rect.Width + border, m_Specification.Alignment);
+			uint32_t height = AlignUp(rect.Height + border, m_Specification.Alignment);
+
+			if (width > m_Specification.PageWidth || height > m_Specification.PageHeight)
+			{
+				m_Stats.FailedCount++;
+				continue;
+			}
+
+			// Earlier pages first, so later pages only receive what no longer fits
+			bool placed = false;
+			for (uint32_t page = 0; page <= (uint32_t)m_Pages.size() && page < m_Specification.MaxPages; page++)
+			{
+				if (page == m_Pages.size())
+					m_Pages.push_back({ { 0, 0, m_Specification.PageWidth } });
+
+				uint32_t x, y;
+				size_t node;
+				if (!FindPosition(m_Pages[page], width, height, x, y, node))
+					continue;
+
+				AddSkylineLevel(m_Pages[page], node, x, y, width, height);
+
+				rect.X = x + lead;
+				rect.Y = y + lead;
+				rect.Page = page;
+				placed = true;
+				break;
+			}
+
+			if (placed)
+			{
+				usedArea += (uint64_t)rect.Width * rect.Height;
+				m_Stats.PackedCount++;
+			}
+			else
+			{
+				m_Stats.FailedCount++;
+			}
+		}
+
+		m_Stats.PageCount = (uint32_t)m_Pages.size();
+		uint64_t pageArea = (uint64_t)m_Specification.PageWidth * m_Specification.PageHeight * m_Stats.PageCount;
+		m_Stats.Efficiency = pageArea ? (float)((double)usedArea / (double)pageArea) : 0.0f;
+		m_Stats.BuildTimeMs = timer.ElapsedMillis();
+
+		return m_Stats.FailedCount == 0;
+	}
+
+	bool TexturePacker::FindPosition(const Skyline& skyline, uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY, size_t& outNode) const
+	{
+		uint32_t bestTop = 0xffffffff;
+		uint32_t bestWidth = 0xffffffff;
+		bool found = false;
+
+		for (size_t i = 0; i < skyline.size(); i++)
+		{
+			uint32_t x = skyline[i].X;
+			if (x + width > m_Specification.PageWidth)
+				break;
+
+			// The rect rests on the highest node it spans
+			uint32_t y = 0;
+			uint32_t remaining = width;
+			for (size_t j = i; remaining > 0; j++)
+			{
+				y = std::max(y, skyline[j].Y);
+				remaining -= std::min(remaining, skyline[j].Width);
+			}
+
+			if (y + height > m_Specification.PageHeight)
+				continue;
+
+			// Bottom-left: lowest top edge wins, ties go to the narrower node (less waste)
+			uint32_t top = y + height;
+			if (top < bestTop || (top == bestTop && skyline[i].Width < bestWidth))
+			{
+				bestTop = top;
+				bestWidth = skyline[i].Width;
+				outX = x;
+				outY = y;
+				outNode = i;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	void TexturePacker::AddSkylineLevel(Skyline& skyline, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		skyline.insert(skyline.begin() + node, { x, y + height, width });
+
+		// Shrink or remove the nodes now covered by the new level
+		for (size_t i = node + 1; i < skyline.size(); )
+		{
+			SkylineNode& previous = skyline[i - 1];
+			SkylineNode& current = skyline[i];
+			uint32_t previousEnd = previous.X + previous.Width;
+			if (current.X >= previousEnd)
+				break;
+
+			uint32_t shrink = previousEnd - current.X;
+			if (current.Width <= shrink)
+			{
+				skyline.erase(skyline.begin() + i);
+				continue;
+			}
+
+			current.X += shrink;
+			current.Width -= shrink;
+			break;
+		}
+
+		// Merge neighbours at the same height
+		for (size_t i = 0; i + 1 < skyline.size(); )
+		{
+			if (skyline[i].Y == skyline[i + 1].Y)
+			{
+				skyline[i].Width += skyline[i + 1].Width;
+				skyline.erase(skyline.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+namespace GLCore::Utils {
+
+	struct TexturePackerSpecification
+	{
+		uint32_t PageWidth = 2048, PageHeight = 2048;
+		uint32_t MaxPages = 16;
+		uint32_t Padding = 1;   // empty texels between neighbouring rects
+		uint32_t Gutter = 0;    // texels of duplicated edge around each rect so filtering/mips don't bleed
+		uint32_t Alignment = 1; // PackRect X/Y are multiples of this (e.g. 4 keeps sprites apart down to mip 2)
+	};
+
+	struct PackRect
+	{
+		// Input
+		uint32_t Width = 0, Height = 0;
+
+		// Output: origin of the image inside the page (gutter excluded)
+		uint32_t X = 0, Y = 0;
+		uint32_t Page = InvalidPage;
+
+		static const uint32_t InvalidPage = 0xffffffff;
+	};
+
+	struct TexturePackerStats
+	{
+		uint32_t PageCount = 0;
+		uint32_t PackedCount = 0;
+		uint32_t FailedCount = 0;
+		float Efficiency = 0.0f; // image area / page area
+		float BuildTimeMs = 0.0f;
+	};
+
+	// Skyline bottom-left rect packer. Works purely on sizes so it can run
+	// headless; TextureAtlas turns the result into GL textures.
+	class TexturePacker
+	{
+	public:
+		TexturePacker(const TexturePackerSpecification& spec = TexturePackerSpecification());
+
+		// Fills X/Y/Page of every rect, opening pages as needed. Returns false if any rect did not fit.
+		bool Pack(std::vector<PackRect>& rects);
+
+		const TexturePackerSpecification& GetSpecification() const { return m_Specification; }
+		const TexturePackerStats& GetStats() const { return m_Stats; }
+	private:
+		struct SkylineNode
+		{
+			uint32_t X, Y, Width;
+		};
+
+		using Skyline = std::vector<SkylineNode>;
+
+		bool FindPosition(const Skyline& skyline, uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY, size_t& outNode) const;
+		void AddSkylineLevel(Skyline& skyline, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+	private:
+		TexturePackerSpecification m_Specification;
+		std::vector<Skyline> m_Pages;
+		TexturePackerStats m_Stats;
+	};
+
+}
@@ -3,6 +3,14 @@
 // Utility header file - include into application for access to utility classes/functions
 
 #include "GLCore/Util/Shader.h"
+#include "GLCore/Util/ShaderCache.h"
+#include "GLCore/Util/ShaderHotReload.h"
+#include "GLCore/Util/ShaderPreprocessor.h"
 #include "GLCore/Util/OrthographicCamera.h"
 #include "GLCore/Util/OrthographicCameraController.h"
-#include "GLCore/Util/OpenGLDebug.h"
\ No newline at end of file
+#include "GLCore/Util/OpenGLDebug.h"
+#include "GLCore/Util/Timer.h"
+#include "GLCore/Util/Texture.h"
+#include "GLCore/Util/TexturePacker.h"
+#include "GLCore/Util/SpatialGrid.h"
+#include "GLCore/Util/CookedTexture.h"
@@ -2,7 +2,7 @@
 
 layout (location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
+#include "GLCore/Camera.glsl"
 
 void main()
 {
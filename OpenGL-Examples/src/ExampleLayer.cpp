@@ -18,17 +18,16 @@ void ExampleLayer::OnAttach()
 {
 	EnableGLDebugging();
 
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLStateCache::Enable(GL_DEPTH_TEST);
+	GLStateCache::Enable(GL_BLEND);
+	GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	m_Shader = Shader::FromGLSLTextFiles(
 		"assets/shaders/test.vert.glsl",
 		"assets/shaders/test.frag.glsl"
 	);
-
-	glCreateVertexArrays(1, &m_QuadVA);
-	glBindVertexArray(m_QuadVA);
+	m_ColorLocation = m_Shader->GetUniformLocation("u_Color");
+	m_Shader->SetReloadCallback([this](Shader& shader) { m_ColorLocation = shader.GetUniformLocation("u_Color"); });
 
 	float vertices[] = {
 		-0.5f, -0.5f, 0.0f,
@@ -37,24 +36,23 @@ void ExampleLayer::OnAttach()
 		-0.5f,  0.5f, 0.0f
 	};
 
-	glCreateBuffers(1, &m_QuadVB);
-	glBindBuffer(GL_ARRAY_BUFFER, m_QuadVB);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	glEnableVertexArrayAttrib(m_QuadVB, 0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, 0);
+	auto quadVB = std::make_shared<VertexBuffer>(vertices, (uint32_t)sizeof(vertices));
+	quadVB->SetLayout({
+		{ VertexElementType::Float3, "a_Position" }
+	});
 
 	uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
-	glCreateBuffers(1, &m_QuadIB);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_QuadIB);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+	auto quadIB = std::make_shared<IndexBuffer>(indices, 6);
+
+	m_QuadVA = std::make_unique<VertexArray>();
+	m_QuadVA->AddVertexBuffer(quadVB);
+	m_QuadVA->SetIndexBuffer(quadIB);
 }
 
 void ExampleLayer::OnDetach()
 {
-	glDeleteVertexArrays(1, &m_QuadVA);
-	glDeleteBuffers(1, &m_QuadVB);
-	glDeleteBuffers(1, &m_QuadIB);
+	m_QuadVA.reset();
+	GLStateCache::Invalidate();
 }
 
 void ExampleLayer::OnEvent(Event& event)
@@ -83,16 +81,13 @@ void ExampleLayer::OnUpdate(Timestep ts)
 	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glUseProgram(m_Shader->GetRendererID());
-
-	int location = glGetUniformLocation(m_Shader->GetRendererID(), "u_ViewProjection");
-	glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m_CameraController.GetCamera().GetViewProjectionMatrix()));
+	FrameUniforms::SetCamera(m_CameraController.GetCamera());
+	m_Shader->SetFloat4(m_ColorLocation, m_SquareColor);
 
-	location = glGetUniformLocation(m_Shader->GetRendererID(), "u_Color");
-	glUniform4fv(location, 1, glm::value_ptr(m_SquareColor));
+	GLStateCache::UseProgram(m_Shader->GetRendererID());
 
-	glBindVertexArray(m_QuadVA);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+	m_QuadVA->Bind();
+	glDrawElements(GL_TRIANGLES, m_QuadVA->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
 }
 
 void ExampleLayer::OnImGuiRender()
@@ -16,9 +16,10 @@ public:
 	virtual void OnImGuiRender() override;
 private:
 	GLCore::Utils::Shader* m_Shader;
+	GLint m_ColorLocation = -1;
 	GLCore::Utils::OrthographicCameraController m_CameraController;
 	
-	GLuint m_QuadVA, m_QuadVB, m_QuadIB;
+	std::unique_ptr<GLCore::VertexArray> m_QuadVA;
 
 	glm::vec4 m_SquareBaseColor = { 0.8f, 0.2f, 0.3f, 1.0f };
 	glm::vec4 m_SquareAlternateColor = { 0.2f, 0.3f, 0.8f, 1.0f };
@@ -2,9 +2,9 @@
 
 layout (location = 0) out vec4 o_Color;
 
-uniform vec4 u_Color;
+flat in vec4 v_Color;
 
 void main()
 {
-	o_Color = u_Color;
+	o_Color = v_Color;
 }
@@ -1,11 +1,26 @@
 #version 450 core
 
 layout (location = 0) in vec3 a_Position;
+layout (location = 1) in uint a_DrawIndex;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+struct DrawData
+{
+	mat4 Transform;
+	vec4 Color;
+};
+
+layout (std430, binding = 1) readonly buffer DrawDataBuffer
+{
+	DrawData s_DrawData[];
+};
+
+#include "GLCore/Camera.glsl"
+
+flat out vec4 v_Color;
 
 void main()
 {
-	gl_Position =  u_ViewProjection * u_Transform * vec4(a_Position, 1.0f);
+	DrawData drawData = s_DrawData[a_DrawIndex];
+	v_Color = drawData.Color;
+	gl_Position =  u_ViewProjection * drawData.Transform * vec4(a_Position, 1.0f);
 }
@@ -28,6 +28,20 @@ project "OpenGL-Sandbox"
 		"OpenGL-Core"
 	}
 
+	dependson
+	{
+		"OpenGL-TextureCooker",
+		"OpenGL-AssetPacker"
+	}
+
+	-- Only textures that changed since the last build are recooked, the pack is
+	-- only rebuilt when an asset changed
+	prebuildcommands
+	{
+		'"%{wks.location}/bin/' .. outputdir .. '/OpenGL-TextureCooker/OpenGL-TextureCooker" assets/textures assets/cooked',
+		'"%{wks.location}/bin/' .. outputdir .. '/OpenGL-AssetPacker/OpenGL-AssetPacker" assets.pak assets/shaders assets/textures assets/cooked'
+	}
+
 	filter "system:windows"
 		systemversion "latest"
 
@@ -1,32 +1,8 @@
 #include "BatchRenderingLayer.h"
-#include <stb_image/stb_image.h>
 
 using namespace GLCore;
 using namespace GLCore::Utils;
 
-struct Vec2
-{
-	float x, y;
-};
-
-struct Vec3
-{
-	float x, y, z;
-};
-
-struct Vec4
-{
-	float x, y, z, w;
-};
-
-struct Vertex
-{
-	Vec3 Position;
-	Vec4 Color;
-	Vec2 TexCoords;
-	float TexIndex;
-};
-
 BatchRenderingLayer::BatchRenderingLayer()
 	: m_CameraController(16.0f / 9.0f)
 {
@@ -36,105 +12,41 @@ BatchRenderingLayer::~BatchRenderingLayer()
 {
 }
 
-static GLuint LoadTexture(const std::string& path)
-{
-	int w, h, bits;
-
-	stbi_set_flip_vertically_on_load(1);
-	auto* pixels = stbi_load(path.c_str(), &w, &h, &bits, STBI_rgb);
-
-	GLuint textureID;
-	glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
-	glBindTexture(GL_TEXTURE_2D, textureID);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels);
-
-	stbi_image_free(pixels);
-	return textureID;
-}
-
 void BatchRenderingLayer::OnAttach()
 {
 	EnableGLDebugging();
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	m_Shader = Shader::FromGLSLTextFiles(
-		"assets/shaders/batch.vert.glsl",
-		"assets/shaders/batch.frag.glsl"
-	);
-
-	glUseProgram(m_Shader->GetRendererID());
-	auto loc = glGetUniformLocation(m_Shader->GetRendererID(), "u_Textures");
-	int samplers[2] = { 0, 1 };
-	glUniform1iv(loc, 2, samplers);
+	GLStateCache::Enable(GL_BLEND);
+	GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
-	const size_t MaxQuadCount = 1000;
-	const size_t MaxVertexCount = MaxQuadCount * 4;
-	const size_t MaxIndexCount = MaxQuadCount * 6;
+	// Each image is decoded once and shared by the standalone textures, the atlas and the array
+	const char* chernoPath = "assets/textures/Cherno.png";
+	const char* hazelPath = "assets/textures/Hazel.png";
+	Image chernoImage = Image::FromFile(chernoPath);
+	Image hazelImage = Image::FromFile(hazelPath);
 
-	glCreateVertexArrays(1, &m_QuadVA);
-	glBindVertexArray(m_QuadVA);
+	m_ChernoTexture = TextureLibrary::Load(chernoPath, chernoImage);
+	m_HazelTexture = TextureLibrary::Load(hazelPath, hazelImage);
 
-	glCreateBuffers(1, &m_QuadVB);
-	glBindBuffer(GL_ARRAY_BUFFER, m_QuadVB);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * MaxVertexCount, nullptr, GL_DYNAMIC_DRAW);
+	m_Atlas = std::make_unique<TextureAtlas>();
+	m_ChernoSprite = m_Atlas->Add(chernoImage);
+	m_HazelSprite = m_Atlas->Add(hazelImage);
+	m_Atlas->Build();
 
-	// position
-	glEnableVertexArrayAttrib(m_QuadVB, 0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, Position));
-
-	// color
-	glEnableVertexArrayAttrib(m_QuadVB, 1);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, Color));
-
-	// texcoord
-	glEnableVertexArrayAttrib(m_QuadVB, 2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, TexCoords));
-
-	// texindex
-	glEnableVertexArrayAttrib(m_QuadVB, 3);
-	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, TexIndex));
-
-	//uint32_t indices[] = {
-	//	0, 1, 2, 2, 3, 0,
-	//	4, 5, 6, 6, 7, 4
-	//};
-
-	uint32_t indices[MaxIndexCount];
-	uint32_t offset = 0; // offset = num iterations * 4
-	for (size_t i = 0; i < MaxIndexCount; i += 6)
-	{
-		indices[i + 0] = 0 + offset;
-		indices[i + 1] = 1 + offset;
-		indices[i + 2] = 2 + offset;
-
-		indices[i + 3] = 2 + offset;
-		indices[i + 4] = 3 + offset;
-		indices[i + 5] = 0 + offset;
-
-		offset += 4;
-	}
-
-	glCreateBuffers(1, &m_QuadIB);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_QuadIB);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	m_ChernoTex = LoadTexture("assets/textures/Cherno.png");
-	m_HazelTex = LoadTexture("assets/textures/Hazel.png");
+	// Hazel.png is larger than Cherno.png and gets resized to fit
+	m_TextureArray = LoadTextureArrayFromImages({ &chernoImage, &hazelImage });
 }
 
 void BatchRenderingLayer::OnDetach()
 {
-	glDeleteVertexArrays(1, &m_QuadVA);
-	glDeleteBuffers(1, &m_QuadVB);
-	glDeleteBuffers(1, &m_QuadIB);
+	m_StaticGrid.reset();
+	m_Atlas.reset();
+	m_ChernoTexture.reset();
+	m_HazelTexture.reset();
+	glDeleteTextures(1, &m_TextureArray);
+	GLStateCache::Invalidate();
 }
 
 void BatchRenderingLayer::OnEvent(Event& event)
@@ -142,77 +54,91 @@ void BatchRenderingLayer::OnEvent(Event& event)
 	m_CameraController.OnEvent(event);
 }
 
-static void SetUniformMat4(uint32_t shader, const char* name, const glm::mat4& matrix)
-{
-	int loc = glGetUniformLocation(shader, name);
-	glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(matrix));
-}
-
-static Vertex* CreateQuad(Vertex* target, float x, float y, float texIndex)
-{
-	float size = 1.f;
-
-	target->Position = { x, y, 0.0f };
-	target->Color = { 0.18f, 0.6f, 0.96f, 1.0f };
-	target->TexCoords = { 0.0f, 0.0f };
-	target->TexIndex = texIndex;
-	target++;
-
-	target->Position = { x + size, y, 0.0f };
-	target->Color = { 0.18f, 0.6f, 0.96f, 1.0f };
-	target->TexCoords = { 1.0f, 0.0f };
-	target->TexIndex = texIndex;
-	target++;
-
-	target->Position = { x + size, y + size, 0.0f };
-	target->Color = { 0.18f, 0.6f, 0.96f, 1.0f };
-	target->TexCoords = { 1.0f, 1.0f };
-	target->TexIndex = texIndex;
-	target++;
-
-	target->Position = { x, y + size, 0.0f };
-	target->Color = { 0.18f, 0.6f, 0.96f, 1.0f };
-	target->TexCoords = { 0.0f, 1.0f };
-	target->TexIndex = texIndex;
-	target++;
-
-	return target;
-}
-
 void BatchRenderingLayer::OnUpdate(Timestep ts)
 {
 	m_CameraController.OnUpdate(ts);
 
-	uint32_t indexCount = 0;
+	Renderer2D::ResetStats();
+
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	Renderer2D::BeginScene(m_CameraController.GetCamera());
 
-	std::array<Vertex, 1000> vertices;
-	Vertex* buffer = vertices.data();
-	for (int y = 0; y < 5; y++)
+	auto drawGridQuad = [this](int x, int y)
 	{
-		for (int x = 0; x < 5; x++)
+		if (m_UseTextureArray)
 		{
-			buffer = CreateQuad(buffer, x, y, (x + y) % 2);
-			indexCount += 6;
+			TextureLayer layer = { m_TextureArray, (uint32_t)(x + y) % 2 };
+			Renderer2D::DrawQuad({ (float)x, (float)y }, { 1.0f, 1.0f }, layer);
 		}
-	}
-	buffer = CreateQuad(buffer, m_QuadPosition[0], m_QuadPosition[1], 0.f);
-	indexCount += 6;
+		else if (m_UseAtlas)
+		{
+			const SubTexture& sprite = m_Atlas->GetSubTexture((x + y) % 2 ? m_HazelSprite : m_ChernoSprite);
+			Renderer2D::DrawQuad({ (float)x, (float)y }, { 1.0f, 1.0f }, sprite);
+		}
+		else
+		{
+			const Texture2D& texture = (x + y) % 2 ? *m_HazelTexture : *m_ChernoTexture;
+			Renderer2D::DrawQuad({ (float)x, (float)y }, { 1.0f, 1.0f }, texture.GetRendererID());
+		}
+	};
 
-	glBindBuffer(GL_ARRAY_BUFFER, m_QuadVB);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+	if (m_UseRetainedGrid)
+	{
+		if (!m_StaticGrid || m_StaticGridSize != m_GridSize || m_StaticGridUsesAtlas != m_UseAtlas)
+		{
+			m_StaticGrid = std::make_unique<StaticQuadBatch>();
+			for (int y = 0; y < m_GridSize; y++)
+			{
+				for (int x = 0; x < m_GridSize; x++)
+				{
+					glm::vec3 position = { (float)x, (float)y, 0.0f };
+					if (m_UseAtlas)
+						m_StaticGrid->Add(position, { 1.0f, 1.0f }, m_Atlas->GetSubTexture((x + y) % 2 ? m_HazelSprite : m_ChernoSprite));
+					else
+						m_StaticGrid->Add(position, { 1.0f, 1.0f }, ((x + y) % 2 ? m_HazelTexture : m_ChernoTexture)->GetRendererID());
+				}
+			}
+			m_StaticGridSize = m_GridSize;
+			m_StaticGridUsesAtlas = m_UseAtlas;
+		}
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		Renderer2D::DrawStaticBatch(*m_StaticGrid);
+	}
+	else if (m_UseCulling)
+	{
+		// The grid is static, rebuild the index only when its size changes
+		if (m_SpatialGridSize != m_GridSize)
+		{
+			SpatialGridSpecification spec;
+			spec.WorldMin = { -1.0f, -1.0f };
+			spec.WorldMax = { (float)m_GridSize + 1.0f, (float)m_GridSize + 1.0f };
+			spec.CellSize = 8.0f;
+			m_SpatialGrid = std::make_unique<SpatialGrid>(spec);
+
+			for (int y = 0; y < m_GridSize; y++)
+				for (int x = 0; x < m_GridSize; x++)
+					m_SpatialGrid->Insert({ (float)x, (float)y }, { 0.5f, 0.5f }, (uint32_t)(y * m_GridSize + x));
+			m_SpatialGridSize = m_GridSize;
+		}
 
-	glUseProgram(m_Shader->GetRendererID());
-	glBindTextureUnit(0, m_ChernoTex);
-	glBindTextureUnit(1, m_HazelTex);
+		glm::vec2 visibleMin, visibleMax;
+		m_CameraController.GetCamera().GetVisibleBounds(visibleMin, visibleMax);
 
-	auto vp = m_CameraController.GetCamera().GetViewProjectionMatrix();
-	SetUniformMat4(m_Shader->GetRendererID(), "u_ViewProjection", vp);
-	SetUniformMat4(m_Shader->GetRendererID(), "u_Transform", glm::mat4(1.f));
+		m_VisibleQuads.clear();
+		m_SpatialGrid->Query(visibleMin, visibleMax, m_VisibleQuads);
+		for (uint32_t index : m_VisibleQuads)
+			drawGridQuad((int)index % m_GridSize, (int)index / m_GridSize);
+	}
+	else
+	{
+		for (int y = 0; y < m_GridSize; y++)
+			for (int x = 0; x < m_GridSize; x++)
+				drawGridQuad(x, y);
+	}
+	Renderer2D::DrawQuad({ m_QuadPosition[0], m_QuadPosition[1] }, { 1.0f, 1.0f }, m_ChernoTexture->GetRendererID());
 
-	glBindVertexArray(m_QuadVA);
-	glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+	Renderer2D::EndScene();
 }
 
 void BatchRenderingLayer::OnImGuiRender()
@@ -220,5 +146,46 @@ void BatchRenderingLayer::OnImGuiRender()
 	// ImGui here
 	ImGui::Begin("Controls");
 	ImGui::DragFloat2("Quad Position", m_QuadPosition, 0.1f);
+	ImGui::DragInt("Grid Size", &m_GridSize, 1.0f, 1, 1000);
+	ImGui::Checkbox("Use Atlas", &m_UseAtlas);
+	ImGui::Checkbox("Use Texture Array", &m_UseTextureArray);
+	ImGui::Checkbox("Culling", &m_UseCulling);
+	ImGui::Checkbox("Retained Grid", &m_UseRetainedGrid);
+
+	int path = (int)Renderer2D::GetPath();
+	const char* paths[] = { "Vertex Batch", "Vertex Pulling" };
+	if (ImGui::Combo("Path", &path, paths, 2))
+		Renderer2D::SetPath((Renderer2DPath)path);
+
+	int format = (int)Renderer2D::GetVertexFormat();
+	const char* formats[] = { "Standard (40 B)", "Compact (20 B)", "CompactHalf (16 B)" };
+	if (ImGui::Combo("Vertex Format", &format, formats, 3))
+		Renderer2D::SetVertexFormat((QuadVertexFormat)format);
+
+	auto& stats = Renderer2D::GetStats();
+	ImGui::Text("Renderer2D Stats:");
+	ImGui::Text("Draw Calls: %d", stats.DrawCalls);
+	ImGui::Text("Quads: %d", stats.QuadCount);
+	ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
+	ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+	ImGui::Text("Uploaded: %.2f KB", stats.UploadedBytes / 1024.0f);
+	ImGui::Text("Static Chunk Rebuilds: %d", stats.StaticChunkRebuilds);
+	ImGui::Text("Texture Slots: %d", Renderer2D::GetMaxTextureSlots());
+
+	auto& libraryStats = TextureLibrary::GetStats();
+	ImGui::Text("Textures: %d resident (%.2f MB), %d of %d loads from the cache", libraryStats.ResidentCount,
+		libraryStats.ResidentBytes / (1024.0f * 1024.0f), libraryStats.Hits, libraryStats.Requests);
+
+	bool stateCacheEnabled = GLStateCache::IsEnabled();
+	if (ImGui::Checkbox("GL State Cache", &stateCacheEnabled))
+		GLStateCache::SetEnabled(stateCacheEnabled);
+
+	auto& stateStats = GLStateCache::GetStats();
+	ImGui::Text("State Calls: %d issued, %d elided", stateStats.GetTotalIssued(), stateStats.GetTotalElided());
+	for (int call = 0; call < (int)GLStateCall::Count; call++)
+	{
+		ImGui::Text("  %-12s %5d / %5d", GLStateCache::GetCallName((GLStateCall)call),
+			stateStats.Issued[call], stateStats.Elided[call]);
+	}
 	ImGui::End();
 }
@@ -16,10 +16,30 @@ public:
 	virtual void OnImGuiRender() override;
 
 private:
-	GLCore::Utils::Shader* m_Shader;
 	GLCore::Utils::OrthographicCameraController m_CameraController;
-	GLuint m_QuadVA, m_QuadVB, m_QuadIB;
-	GLuint m_ChernoTex, m_HazelTex;
+	// Shared through the TextureLibrary, so re-attaching the layer reuses them
+	std::shared_ptr<GLCore::Texture2D> m_ChernoTexture, m_HazelTexture;
+
+	std::unique_ptr<GLCore::TextureAtlas> m_Atlas;
+	uint32_t m_ChernoSprite, m_HazelSprite;
+	bool m_UseAtlas = false;
+
+	// Both images as layers of one GL_TEXTURE_2D_ARRAY
+	GLuint m_TextureArray = 0;
+	bool m_UseTextureArray = false;
 
 	float m_QuadPosition[2] = { -1.5, -0.5 };
+	int m_GridSize = 5;
+
+	// Only submit the grid quads the camera can see
+	bool m_UseCulling = false;
+	std::unique_ptr<GLCore::Utils::SpatialGrid> m_SpatialGrid;
+	int m_SpatialGridSize = 0;
+	std::vector<uint32_t> m_VisibleQuads;
+
+	// Keep the grid in immutable GPU chunks, only the moving quad is streamed
+	bool m_UseRetainedGrid = false;
+	std::unique_ptr<GLCore::StaticQuadBatch> m_StaticGrid;
+	int m_StaticGridSize = 0;
+	bool m_StaticGridUsesAtlas = false;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "BenchmarkLayer.h"
+
+using namespace GLCore;
+
+BenchmarkLayer::BenchmarkLayer()
+	: Layer("BenchmarkLayer")
+{
+}
+
+BenchmarkLayer::~BenchmarkLayer()
+{
+}
+
+void BenchmarkLayer::OnAttach()
+{
+	for (auto& benchmark : m_Benchmarks)
+		benchmark->OnAttach();
+}
+
+void BenchmarkLayer::OnDetach()
+{
+	for (auto& benchmark : m_Benchmarks)
+		benchmark->OnDetach();
+	GLStateCache::Invalidate();
+}
+
+void BenchmarkLayer::OnUpdate(Timestep ts)
+{
+	for (auto& benchmark : m_Benchmarks)
+		benchmark->OnUpdate();
+}
+
+void BenchmarkLayer::OnImGuiRender()
+{
+	ImGui::Begin("Benchmarks");
+	for (auto& benchmark : m_Benchmarks)
+	{
+		// Labels only need to be unique within a panel
+		ImGui::PushID(benchmark.get());
+		if (ImGui::CollapsingHeader(benchmark->GetName().c_str()))
+			benchmark->OnImGuiRender();
+		ImGui::PopID();
+	}
+	ImGui::End();
+}
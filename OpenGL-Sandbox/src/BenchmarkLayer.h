@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Benchmarks/Benchmark.h"
+
+// Hosts the benchmark panels in one "Benchmarks" window, one collapsing
+// header each, in the order they were added
+class BenchmarkLayer : public GLCore::Layer
+{
+public:
+	BenchmarkLayer();
+	virtual ~BenchmarkLayer();
+
+	template<typename T, typename... Args>
+	void AddBenchmark(Args&&... args)
+	{
+		m_Benchmarks.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+	}
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+	virtual void OnUpdate(GLCore::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+private:
+	std::vector<std::unique_ptr<Benchmark>> m_Benchmarks;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Reading every packed asset from its loose file against the mapped pack
+class AssetPackBenchmark : public Benchmark
+{
+public:
+	AssetPackBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	float m_LooseMs = 0.0f;
+	float m_PackMs = 0.0f;
+	uint64_t m_Bytes = 0;
+};
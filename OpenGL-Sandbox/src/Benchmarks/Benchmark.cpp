@@ -0,0 +1,38 @@
+#include "Benchmark.h"
+
+namespace BenchmarkUtils {
+
+	const char* const TexturePaths[TextureCount] = { "assets/textures/Cherno.png", "assets/textures/Hazel.png" };
+	const char* const CookedTexturePaths[TextureCount] = { "assets/cooked/Cherno.gltex", "assets/cooked/Hazel.gltex" };
+
+	const char* const PositionVertexShader = R"(
+		#version 450 core
+
+		layout (location = 0) in vec3 a_Position;
+
+		void main()
+		{
+			gl_Position = vec4(a_Position, 1.0f);
+		}
+	)";
+
+	const char* const WhiteFragmentShader = R"(
+		#version 450 core
+
+		layout (location = 0) out vec4 o_Color;
+
+		void main()
+		{
+			o_Color = vec4(1.0f);
+		}
+	)";
+
+	uint64_t HashBytes(const void* data, size_t size, uint64_t hash)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		return hash;
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <GLCore.h>
+#include <GLCoreUtils.h>
+
+// One section of the Benchmarks window. Each panel lives in its own file
+// and is added to BenchmarkLayer by SandboxApp; the layer forwards attach,
+// detach and update and draws OnImGuiRender under a header named GetName().
+class Benchmark
+{
+public:
+	Benchmark(const std::string& name)
+		: m_Name(name) {}
+	virtual ~Benchmark() = default;
+
+	virtual void OnAttach() {}
+	virtual void OnDetach() {}
+	virtual void OnUpdate() {}
+	virtual void OnImGuiRender() = 0;
+
+	inline const std::string& GetName() const { return m_Name; }
+private:
+	std::string m_Name;
+};
+
+// Inputs and helpers shared by the benchmark panels
+namespace BenchmarkUtils {
+
+	static const uint32_t TextureCount = 2;
+	// The Sandbox textures, and what OpenGL-TextureCooker makes of them
+	extern const char* const TexturePaths[TextureCount];
+	extern const char* const CookedTexturePaths[TextureCount];
+
+	// Position only vertex shader and a white fragment shader, cheap to build
+	extern const char* const PositionVertexShader;
+	extern const char* const WhiteFragmentShader;
+
+	// Milliseconds fn takes; with finish the GL work it queued is waited for too
+	template<typename Fn>
+	float MeasureMillis(Fn&& fn, bool finish = false)
+	{
+		GLCore::Utils::Timer timer;
+		fn();
+		if (finish)
+			glFinish();
+		return timer.ElapsedMillis();
+	}
+
+	// FNV-1a, continues from hash; equal hashes mean identical output
+	uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull);
+
+}
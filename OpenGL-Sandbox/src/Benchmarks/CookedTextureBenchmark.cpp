@@ -0,0 +1,54 @@
+#include "CookedTextureBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+CookedTextureBenchmark::CookedTextureBenchmark()
+	: Benchmark("Cooked Textures")
+{
+}
+
+void CookedTextureBenchmark::OnImGuiRender()
+{
+	if (ImGui::Button("Load"))
+	{
+		m_Results.clear();
+		m_Missing = false;
+		for (uint32_t i = 0; i < BenchmarkUtils::TextureCount; i++)
+		{
+			Result result = {};
+			result.Name = BenchmarkUtils::TexturePaths[i];
+
+			GLuint texture = 0;
+			result.ImageMs = BenchmarkUtils::MeasureMillis([&]() { texture = LoadTexture(BenchmarkUtils::TexturePaths[i]); }, true);
+
+			GLint width, height;
+			glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_WIDTH, &width);
+			glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_HEIGHT, &height);
+			result.ImageBytes = (uint64_t)width * height * 3; // LoadTexture stores RGB8 without mips
+			glDeleteTextures(1, &texture);
+
+			result.CookedMs = BenchmarkUtils::MeasureMillis([&]() { texture = LoadCookedTexture(BenchmarkUtils::CookedTexturePaths[i], &result.Info); }, true);
+			result.CookedBytes = result.Info.MemorySize;
+			glDeleteTextures(1, &texture);
+
+			m_Missing |= texture == 0;
+			m_Results.push_back(result);
+		}
+		GLStateCache::Invalidate();
+	}
+
+	if (m_Missing)
+		ImGui::Text("Missing or unsupported .gltex files, build OpenGL-TextureCooker and the Sandbox to cook assets/textures");
+
+	for (const Result& result : m_Results)
+	{
+		ImGui::Text("%s", result.Name);
+		ImGui::Text("  PNG decode + upload: %8.1f ms  %8.1f MB (1 level)", result.ImageMs, result.ImageBytes / (1024.0f * 1024.0f));
+		if (result.CookedBytes)
+		{
+			ImGui::Text("  Cooked %-5s upload: %8.1f ms  %8.1f MB (%u levels)", GetCookedTextureFormatName(result.Info.Format),
+				result.CookedMs, result.CookedBytes / (1024.0f * 1024.0f), result.Info.LevelCount);
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Decoding the PNGs against uploading the cooker's .gltex files
+class CookedTextureBenchmark : public Benchmark
+{
+public:
+	CookedTextureBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	struct Result
+	{
+		const char* Name;
+		float ImageMs, CookedMs;
+		uint64_t ImageBytes, CookedBytes;
+		GLCore::Utils::CookedTextureInfo Info;
+	};
+
+	std::vector<Result> m_Results;
+	bool m_Missing = false;
+};
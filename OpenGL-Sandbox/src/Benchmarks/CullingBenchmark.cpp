@@ -0,0 +1,105 @@
+#include "CullingBenchmark.h"
+
+#include <random>
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+CullingBenchmark::CullingBenchmark()
+	: Benchmark("Culling")
+{
+}
+
+void CullingBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Sprites", &m_SpriteCount, 1000.0f, 1, 4000000);
+
+	if (ImGui::Button("Query"))
+	{
+		// Sprites scattered over a square world with roughly one sprite per unit
+		uint32_t count = (uint32_t)m_SpriteCount;
+		float worldSize = std::sqrt((float)count);
+
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<float> position(0.0f, worldSize);
+		std::uniform_real_distribution<float> halfSize(0.1f, 1.0f);
+
+		std::vector<glm::vec2> centers(count), halfSizes(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			centers[i] = { position(rng), position(rng) };
+			halfSizes[i] = glm::vec2(halfSize(rng));
+		}
+
+		SpatialGridSpecification spec;
+		spec.WorldMin = { 0.0f, 0.0f };
+		spec.WorldMax = { worldSize, worldSize };
+		spec.CellSize = 8.0f;
+		SpatialGrid grid(spec);
+
+		std::vector<uint32_t> handles(count);
+		m_InsertMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+				handles[i] = grid.Insert(centers[i], halfSizes[i], i);
+		});
+
+		// A tenth of the world moving a little every frame
+		m_MoveMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (uint32_t i = 0; i < count; i += 10)
+			{
+				centers[i] += glm::vec2(0.5f, -0.25f);
+				grid.Move(handles[i], centers[i], halfSizes[i]);
+			}
+		});
+
+		OrthographicCameraController cameraController(16.0f / 9.0f);
+		cameraController.GetCamera().SetPosition({ worldSize * 0.5f, worldSize * 0.5f, 0.0f });
+
+		m_Results.clear();
+		std::vector<uint32_t> visible;
+		for (float zoomLevel : { 1.0f, 4.0f, 16.0f, 64.0f, 256.0f })
+		{
+			cameraController.SetZoomLevel(zoomLevel);
+			glm::vec2 visibleMin, visibleMax;
+			cameraController.GetCamera().GetVisibleBounds(visibleMin, visibleMax);
+
+			const int repeats = 10;
+			float queryMs = BenchmarkUtils::MeasureMillis([&]()
+			{
+				for (int r = 0; r < repeats; r++)
+				{
+					visible.clear();
+					grid.Query(visibleMin, visibleMax, visible);
+				}
+			}) / repeats;
+
+			// What submitting everything costs just to find out what is visible
+			std::vector<uint32_t> bruteForce;
+			float bruteForceMs = BenchmarkUtils::MeasureMillis([&]()
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					glm::vec2 min = centers[i] - halfSizes[i], max = centers[i] + halfSizes[i];
+					if (max.x >= visibleMin.x && min.x <= visibleMax.x && max.y >= visibleMin.y && min.y <= visibleMax.y)
+						bruteForce.push_back(i);
+				}
+			});
+
+			GLCORE_ASSERT(bruteForce.size() == visible.size(), "SpatialGrid query disagrees with brute force!");
+			m_Results.push_back({ zoomLevel, (uint32_t)visible.size(), queryMs, bruteForceMs });
+		}
+	}
+
+	if (m_Results.empty())
+		return;
+
+	ImGui::Text("Insert: %.3f ms  Move (10%%): %.3f ms", m_InsertMs, m_MoveMs);
+	ImGui::Text("Zoom    Visible    Query ms   Brute ms");
+	for (const Result& result : m_Results)
+	{
+		ImGui::Text("%5.0f   %7u   %8.3f   %8.3f", result.ZoomLevel, result.VisibleCount,
+			result.QueryMs, result.BruteForceMs);
+	}
+}
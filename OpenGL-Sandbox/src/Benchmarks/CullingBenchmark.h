@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// SpatialGrid queries at increasing camera zoom levels against testing every sprite (CPU only)
+class CullingBenchmark : public Benchmark
+{
+public:
+	CullingBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	struct Result
+	{
+		float ZoomLevel;
+		uint32_t VisibleCount;
+		float QueryMs;
+		float BruteForceMs;
+	};
+
+	int m_SpriteCount = 500000;
+	float m_InsertMs = 0.0f;
+	float m_MoveMs = 0.0f;
+	std::vector<Result> m_Results;
+};
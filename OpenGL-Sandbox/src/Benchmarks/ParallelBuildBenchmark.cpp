@@ -0,0 +1,105 @@
+#include "ParallelBuildBenchmark.h"
+
+#include <random>
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+// The built vertices in chunk order
+static uint64_t HashChunks(const ParallelQuadBuilder& builder)
+{
+	uint64_t hash = BenchmarkUtils::HashBytes(nullptr, 0);
+	for (const QuadChunk& chunk : builder.GetChunks())
+		hash = BenchmarkUtils::HashBytes(builder.GetChunkVertices(chunk), (size_t)chunk.QuadCount * 4 * sizeof(QuadVertex), hash);
+	return hash;
+}
+
+ParallelBuildBenchmark::ParallelBuildBenchmark()
+	: Benchmark("Parallel Build")
+{
+}
+
+void ParallelBuildBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Sprites", &m_SpriteCount, 1000.0f, 1, 4000000);
+	ImGui::DragInt("Tasks", &m_TaskCount, 1.0f, 1, 4096);
+	ImGui::Checkbox("Deterministic", &m_Deterministic);
+
+	if (ImGui::Button("Build"))
+	{
+		uint32_t count = (uint32_t)m_SpriteCount;
+		uint32_t taskCount = (uint32_t)m_TaskCount;
+
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> rotation(-10.0f, 10.0f);
+
+		std::vector<float> positionX(count), positionY(count), sizes(count, 1.0f), rotations(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			positionX[i] = position(rng);
+			positionY[i] = position(rng);
+			rotations[i] = rotation(rng);
+		}
+
+		QuadKernelInput input;
+		input.PositionX = positionX.data();
+		input.PositionY = positionY.data();
+		input.SizeX = sizes.data();
+		input.SizeY = sizes.data();
+		input.Rotation = rotations.data();
+		input.Count = count;
+
+		uint32_t spritesPerTask = (count + taskCount - 1) / taskCount;
+		auto task = [&](uint32_t taskIndex, QuadWriter& writer)
+		{
+			uint32_t begin = taskIndex * spritesPerTask;
+			if (begin < count)
+				writer.DrawQuads(input.Slice(begin, std::min(spritesPerTask, count - begin)));
+		};
+
+		// Only submission matters here, nothing needs to reach the screen
+		OrthographicCamera camera(-100.0f, 100.0f, -100.0f, 100.0f);
+		GLStateCache::Enable(GL_RASTERIZER_DISCARD);
+		Renderer2D::BeginScene(camera);
+
+		m_Results.clear();
+		uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+		for (uint32_t threads = 1; ; threads = std::min(threads * 2, maxThreads))
+		{
+			ParallelQuadBuilderSpecification spec;
+			spec.ThreadCount = threads;
+			spec.MaxQuads = count + taskCount * spec.ChunkQuads; // room for every task's partial last chunk
+			spec.Deterministic = m_Deterministic;
+			ParallelQuadBuilder builder(spec);
+
+			// First build touches the arena pages, time the second
+			builder.Build(taskCount, task);
+			float buildMs = BenchmarkUtils::MeasureMillis([&]() { builder.Build(taskCount, task); });
+			uint64_t hash = HashChunks(builder);
+			float uploadDrawMs = BenchmarkUtils::MeasureMillis([&]() { Renderer2D::DrawQuads(builder); });
+
+			// The first pass maps (and may allocate) the stream buffer, time the second
+			Renderer2D::BuildQuads(builder, taskCount, task);
+			float directMs = BenchmarkUtils::MeasureMillis([&]() { Renderer2D::BuildQuads(builder, taskCount, task); });
+
+			m_Results.push_back({ threads, buildMs, uploadDrawMs, directMs, hash });
+			if (threads == maxThreads)
+				break;
+		}
+
+		Renderer2D::EndScene();
+		GLStateCache::Disable(GL_RASTERIZER_DISCARD);
+	}
+
+	if (m_Results.empty())
+		return;
+
+	ImGui::Text("Threads   Build ms   Speedup   Upload+draw ms   Direct ms   Output");
+	for (const Result& result : m_Results)
+	{
+		bool identical = result.Hash == m_Results[0].Hash;
+		ImGui::Text("%7u   %8.3f   %6.2fx   %14.3f   %9.3f   %s", result.ThreadCount, result.BuildMs,
+			m_Results[0].BuildMs / result.BuildMs, result.UploadDrawMs, result.DirectMs, identical ? "identical" : "reordered");
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// ParallelQuadBuilder with 1, 2, 4, ... threads up to the hardware count. The
+// build is then drawn both ways Renderer2D offers: uploading the builder's arena
+// (main thread time after the build) and building straight into GL memory.
+// Drawing uses rasterizer discard, so only submission is measured.
+class ParallelBuildBenchmark : public Benchmark
+{
+public:
+	ParallelBuildBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	struct Result
+	{
+		uint32_t ThreadCount;
+		float BuildMs;
+		float UploadDrawMs;  // DrawQuads after a Build, main thread only
+		float DirectMs;      // BuildQuads, build and draw
+		uint64_t Hash;
+	};
+
+	int m_SpriteCount = 1000000;
+	int m_TaskCount = 64;
+	bool m_Deterministic = true;
+	std::vector<Result> m_Results;
+};
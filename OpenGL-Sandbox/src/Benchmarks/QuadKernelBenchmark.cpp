@@ -0,0 +1,116 @@
+#include "QuadKernelBenchmark.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+QuadKernelBenchmark::QuadKernelBenchmark()
+	: Benchmark("Quad Kernel")
+{
+}
+
+void QuadKernelBenchmark::OnImGuiRender()
+{
+	ImGui::Text("Best ISA: %s", GetQuadKernelISAName(GetSupportedQuadKernelISA()));
+	ImGui::DragInt("Sprites", &m_SpriteCount, 1000.0f, 1, 2000000);
+
+	if (ImGui::Button("Generate"))
+	{
+		uint32_t count = (uint32_t)m_SpriteCount;
+
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> size(0.1f, 4.0f);
+		std::uniform_real_distribution<float> rotation(-10.0f, 10.0f);
+
+		std::vector<float> positionX(count), positionY(count), sizeX(count), sizeY(count), rotations(count);
+		std::vector<glm::vec4> colors(count, { 1.0f, 0.5f, 0.25f, 1.0f });
+		for (uint32_t i = 0; i < count; i++)
+		{
+			positionX[i] = position(rng);
+			positionY[i] = position(rng);
+			sizeX[i] = size(rng);
+			sizeY[i] = size(rng);
+			rotations[i] = rotation(rng);
+		}
+
+		QuadKernelInput input;
+		input.PositionX = positionX.data();
+		input.PositionY = positionY.data();
+		input.SizeX = sizeX.data();
+		input.SizeY = sizeY.data();
+		input.Rotation = rotations.data();
+		input.Color = colors.data();
+		input.Count = count;
+
+		// What ParticleSystem does per quad today: build a full transform and multiply every corner
+		std::vector<QuadVertex> reference(count * 4);
+		m_MatrixMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			const glm::vec4 corners[4] = {
+				{ -0.5f, -0.5f, 0.0f, 1.0f }, { 0.5f, -0.5f, 0.0f, 1.0f },
+				{ 0.5f, 0.5f, 0.0f, 1.0f }, { -0.5f, 0.5f, 0.0f, 1.0f }
+			};
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				glm::mat4 transform = glm::translate(glm::mat4(1.0f), { positionX[i], positionY[i], 0.0f })
+					* glm::rotate(glm::mat4(1.0f), rotations[i], { 0.0f, 0.0f, 1.0f })
+					* glm::scale(glm::mat4(1.0f), { sizeX[i], sizeY[i], 1.0f });
+				for (uint32_t corner = 0; corner < 4; corner++)
+				{
+					QuadVertex& vertex = reference[i * 4 + corner];
+					vertex.Position = glm::vec3(transform * corners[corner]);
+					vertex.Color = colors[i];
+				}
+			}
+		});
+
+		// Every kernel is checked against the exact (std::sin/cos) reference
+		std::vector<QuadVertex> vertices(count * 4);
+		for (int isa = 0; isa < ISACount; isa++)
+		{
+			if (isa > (int)GetSupportedQuadKernelISA())
+			{
+				m_KernelMs[isa] = 0.0f;
+				m_MaxError[isa] = 0.0f;
+				continue;
+			}
+
+			m_KernelMs[isa] = BenchmarkUtils::MeasureMillis([&]() { GenerateQuadVertices((QuadKernelISA)isa, input, vertices.data()); });
+
+			float maxError = 0.0f;
+			for (size_t v = 0; v < vertices.size(); v++)
+			{
+				maxError = std::max(maxError, std::abs(vertices[v].Position.x - reference[v].Position.x));
+				maxError = std::max(maxError, std::abs(vertices[v].Position.y - reference[v].Position.y));
+			}
+			m_MaxError[isa] = maxError;
+		}
+		m_MatchesScalar = VerifyQuadKernels(0);
+		m_Ran = true;
+	}
+
+	if (!m_Ran)
+		return;
+
+	// Positions are at most ~100 units from the origin, so 1e-4 is a few ulps
+	const float epsilon = 1e-4f;
+	ImGui::Text("Kernel     Time ms   Max Error");
+	ImGui::Text("%-8s  %8.3f          -", "glm::mat4", m_MatrixMs);
+	for (int isa = 0; isa < ISACount; isa++)
+	{
+		if (isa > (int)GetSupportedQuadKernelISA())
+		{
+			ImGui::Text("%-8s  unsupported", GetQuadKernelISAName((QuadKernelISA)isa));
+			continue;
+		}
+
+		ImGui::Text("%-8s  %8.3f   %9.2e  %s", GetQuadKernelISAName((QuadKernelISA)isa), m_KernelMs[isa],
+			m_MaxError[isa], m_MaxError[isa] <= epsilon ? "OK" : "MISMATCH");
+	}
+	ImGui::Text("SIMD vs Scalar: %s", m_MatchesScalar ? "bit-exact" : "DIFFERENT (see log)");
+}
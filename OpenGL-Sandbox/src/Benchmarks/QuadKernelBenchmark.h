@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// GenerateQuadVertices per ISA against building a glm::mat4 per sprite (CPU only)
+class QuadKernelBenchmark : public Benchmark
+{
+public:
+	QuadKernelBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	static const int ISACount = 3;
+
+	int m_SpriteCount = 100000;
+	float m_MatrixMs = 0.0f;
+	float m_KernelMs[ISACount] = {};
+	float m_MaxError[ISACount] = {};
+	bool m_MatchesScalar = false;
+	bool m_Ran = false;
+};
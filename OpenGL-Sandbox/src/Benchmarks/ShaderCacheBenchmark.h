@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Building shader variants from source against loading their cached binaries
+class ShaderCacheBenchmark : public Benchmark
+{
+public:
+	ShaderCacheBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	int m_VariantCount = 32;
+	float m_CompileMs = 0.0f;
+	float m_CachedMs = 0.0f;
+};
@@ -0,0 +1,22 @@
+#include "ShaderHotReloadPanel.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+ShaderHotReloadPanel::ShaderHotReloadPanel()
+	: Benchmark("Shader Hot Reload")
+{
+}
+
+void ShaderHotReloadPanel::OnImGuiRender()
+{
+	bool enabled = ShaderHotReload::IsEnabled();
+	if (ImGui::Checkbox("Watch assets/shaders", &enabled))
+		ShaderHotReload::SetEnabled(enabled);
+
+	auto& stats = ShaderHotReload::GetStats();
+	ImGui::Text("Parallel compile: %s", Shader::IsParallelCompileSupported() ? "yes" : "no (collected next frame)");
+	ImGui::Text("%u reloads, %u failed, %u compiling", stats.Reloads, stats.Failures, stats.Pending);
+	if (stats.Reloads > 0)
+		ImGui::Text("Last reload: %.1f ms over %u frames", stats.LastReloadMs, stats.LastReloadFrames);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Toggle and statistics of ShaderHotReload, nothing to measure on demand
+class ShaderHotReloadPanel : public Benchmark
+{
+public:
+	ShaderHotReloadPanel();
+
+	virtual void OnImGuiRender() override;
+};
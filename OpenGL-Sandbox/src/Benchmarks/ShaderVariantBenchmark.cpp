@@ -0,0 +1,55 @@
+#include "ShaderVariantBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+ShaderVariantBenchmark::ShaderVariantBenchmark()
+	: Benchmark("Shader Variants")
+{
+}
+
+void ShaderVariantBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Lookups", &m_LookupCount, 1000.0f, 1000, 1000000);
+
+	if (ImGui::Button("Run"))
+	{
+		// The renderer's own variants, all built by Renderer2D::Init
+		const uint32_t flags[] = {
+			ShaderVariantNone, ShaderVariantTextured, ShaderVariantTextureArray,
+			ShaderVariantVertexPulling | ShaderVariantTextured, ShaderVariantVertexPulling | ShaderVariantTextureArray
+		};
+		const uint32_t flagCount = sizeof(flags) / sizeof(flags[0]);
+
+		GLuint checksum = 0;
+		m_LookupMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (int i = 0; i < m_LookupCount; i++)
+				checksum += Shader::Get("GLCore/Renderer2D", flags[i % flagCount])->GetRendererID();
+		});
+
+		// What every request would cost without the cache, before even compiling
+		int preprocessCount = std::max(m_LookupCount / 100, 1);
+		float preprocessMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (int i = 0; i < preprocessCount; i++)
+			{
+				std::vector<ShaderDefine> defines;
+				if (flags[i % flagCount] & ShaderVariantTextured)
+					defines.push_back({ "TEXTURED" });
+				checksum += (GLuint)ShaderPreprocessor::ProcessFile("GLCore/Renderer2D.frag.glsl", defines).Source.size();
+			}
+		});
+		m_PreprocessMs = preprocessMs * m_LookupCount / preprocessCount;
+		LOG_TRACE("Variant benchmark checksum {0}", checksum);
+	}
+
+	if (m_LookupMs > 0.0f)
+	{
+		ImGui::Text("Shader::Get (cached):    %8.2f ms  (%.0f ns each)", m_LookupMs, m_LookupMs * 1e6f / m_LookupCount);
+		ImGui::Text("Preprocess per request:  %8.2f ms  (extrapolated)", m_PreprocessMs);
+	}
+
+	auto& stats = Shader::GetVariantStats();
+	ImGui::Text("%u variants, %u programs built, %u shared, %u requests", stats.Variants, stats.Builds, stats.Shared, stats.Requests);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Cached Shader::Get lookups against expanding the sources again
+class ShaderVariantBenchmark : public Benchmark
+{
+public:
+	ShaderVariantBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	int m_LookupCount = 100000;
+	float m_LookupMs = 0.0f;
+	float m_PreprocessMs = 0.0f;
+};
@@ -0,0 +1,58 @@
+#include "ShaderWarmupBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+ShaderWarmupBenchmark::ShaderWarmupBenchmark()
+	: Benchmark("Shader Warm-up")
+{
+}
+
+void ShaderWarmupBenchmark::OnImGuiRender()
+{
+	auto& startup = Shader::GetWarmupStats();
+	ImGui::Text("Startup: %u programs (%u cached, %u failed) in %.1f ms", startup.Programs, startup.CacheHits, startup.Failures, startup.TotalMs);
+	ImGui::Text("  preprocess %.1f ms, submit %.1f ms, collect %.1f ms", startup.PreprocessMs, startup.SubmitMs, startup.CollectMs);
+	ImGui::Text("Parallel compile: %s", Shader::IsParallelCompileSupported() ? "yes" : "no");
+
+	ImGui::DragInt("Programs", &m_ProgramCount, 1.0f, 1, 256);
+
+	if (ImGui::Button("Run"))
+	{
+		// Fresh sources every run, so neither our cache nor the driver's can serve them
+		auto makeSources = [&]()
+		{
+			m_Run++;
+			std::vector<std::pair<std::string, std::string>> sources(m_ProgramCount);
+			for (int i = 0; i < m_ProgramCount; i++)
+			{
+				std::string salt = "\n// warm-up " + std::to_string(m_Run) + "." + std::to_string(i) + "\n";
+				sources[i] = { BenchmarkUtils::PositionVertexShader + salt, BenchmarkUtils::WhiteFragmentShader + salt };
+			}
+			return sources;
+		};
+
+		bool enabled = ShaderCache::IsEnabled();
+		ShaderCache::SetEnabled(false);
+
+		std::vector<std::pair<std::string, std::string>> serialSources = makeSources();
+		m_SerialMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (const auto& [vertexSource, fragmentSource] : serialSources)
+				delete Shader::FromGLSLSource(vertexSource, fragmentSource);
+		});
+
+		for (Shader* shader : Shader::FromGLSLSources(makeSources(), &m_Batch))
+			delete shader;
+
+		ShaderCache::SetEnabled(enabled);
+		GLStateCache::Invalidate();
+	}
+
+	if (m_SerialMs > 0.0f)
+	{
+		ImGui::Text("One by one:  %8.1f ms", m_SerialMs);
+		ImGui::Text("Batched:     %8.1f ms  (%.1fx)", m_Batch.TotalMs, m_SerialMs / m_Batch.TotalMs);
+		ImGui::Text("  submit %.1f ms, collect %.1f ms", m_Batch.SubmitMs, m_Batch.CollectMs);
+	}
+}
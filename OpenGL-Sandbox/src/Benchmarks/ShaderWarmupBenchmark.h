@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Compiling one program after another against one submitted batch
+class ShaderWarmupBenchmark : public Benchmark
+{
+public:
+	ShaderWarmupBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	int m_ProgramCount = 32;
+	uint32_t m_Run = 0;
+	float m_SerialMs = 0.0f;
+	GLCore::Utils::Shader::WarmupStatistics m_Batch;
+};
@@ -0,0 +1,57 @@
+#include "SortBenchmark.h"
+
+#include <random>
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+SortBenchmark::SortBenchmark()
+	: Benchmark("Render Queue Sort")
+{
+}
+
+void SortBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Commands", &m_KeyCount, 1000.0f, 1, 4000000);
+
+	if (ImGui::Button("Sort"))
+	{
+		// Realistic keys: a few layers/shaders/textures, random depth, a quarter translucent
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<uint32_t> small(0, 7);
+		std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+
+		uint32_t count = (uint32_t)m_KeyCount;
+		std::vector<uint64_t> keys(count);
+		for (uint64_t& key : keys)
+			key = RenderQueue::EncodeKey((uint8_t)(small(rng) & 3), small(rng) < 2, small(rng) + 1, small(rng) + 1, depth(rng));
+
+		std::vector<std::pair<uint64_t, uint32_t>> comparison(count);
+		for (uint32_t i = 0; i < count; i++)
+			comparison[i] = { keys[i], i };
+
+		std::vector<uint32_t> values(count), valueScratch(count);
+		std::vector<uint64_t> keyScratch(count);
+		for (uint32_t i = 0; i < count; i++)
+			values[i] = i;
+
+		m_RadixSortMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			RadixSort(keys.data(), values.data(), keyScratch.data(), valueScratch.data(), count);
+		});
+
+		m_ComparisonSortMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			std::stable_sort(comparison.begin(), comparison.end(),
+				[](const auto& a, const auto& b) { return a.first < b.first; });
+		});
+
+		m_ResultsMatch = true;
+		for (uint32_t i = 0; i < count; i++)
+			m_ResultsMatch &= comparison[i].second == values[i];
+	}
+
+	ImGui::Text("Radix sort:       %.3f ms", m_RadixSortMs);
+	ImGui::Text("std::stable_sort: %.3f ms", m_ComparisonSortMs);
+	ImGui::Text("Results: %s", m_ResultsMatch ? "identical" : "MISMATCH");
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// RenderQueue's radix sort against std::stable_sort on realistic keys (CPU only)
+class SortBenchmark : public Benchmark
+{
+public:
+	SortBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	int m_KeyCount = 100000;
+	float m_RadixSortMs = 0.0f;
+	float m_ComparisonSortMs = 0.0f;
+	bool m_ResultsMatch = true;
+};
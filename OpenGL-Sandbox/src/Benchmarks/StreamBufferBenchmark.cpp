@@ -0,0 +1,125 @@
+#include "StreamBufferBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+static const uint32_t s_QuadCounts[] = { 10000, 100000, 1000000 };
+static const uint32_t s_ChunkQuads = 10000;
+static const int s_WarmupFrames = 5;
+static const int s_MeasuredFrames = 60;
+
+StreamBufferBenchmark::StreamBufferBenchmark()
+	: Benchmark("Stream Buffer")
+{
+}
+
+void StreamBufferBenchmark::OnAttach()
+{
+	m_Shader = Shader::FromGLSLSource(BenchmarkUtils::PositionVertexShader, BenchmarkUtils::WhiteFragmentShader);
+
+	glCreateVertexArrays(1, &m_VertexArray);
+	VertexArray::ApplyLayout(m_VertexArray, BufferLayout::Create<QuadVertex>({
+		GLCORE_VERTEX_ELEMENT(QuadVertex, Position)
+	}), 0);
+
+	std::vector<QuadVertex> vertices(s_ChunkQuads * 4);
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		vertices[i].Position = { (float)(i % 100), (float)(i / 100), 0.0f };
+		vertices[i].Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		vertices[i].TexCoord = { 0.0f, 0.0f };
+		vertices[i].TexIndex = 0.0f;
+	}
+	m_Staging.resize(vertices.size() * sizeof(QuadVertex));
+	memcpy(m_Staging.data(), vertices.data(), m_Staging.size());
+}
+
+void StreamBufferBenchmark::OnDetach()
+{
+	m_StreamBuffer.reset();
+	glDeleteVertexArrays(1, &m_VertexArray);
+	delete m_Shader;
+}
+
+void StreamBufferBenchmark::OnUpdate()
+{
+	if (!m_Running)
+		return;
+
+	StreamBufferStrategy strategy = (StreamBufferStrategy)m_Strategy;
+	if (!m_StreamBuffer)
+		m_StreamBuffer = std::make_unique<StreamBuffer>((uint32_t)m_Staging.size(), strategy);
+
+	// Points with rasterization disabled: the GPU still fetches every vertex,
+	// so buffer synchronization behaves like a real frame without fill cost
+	GLStateCache::Enable(GL_RASTERIZER_DISCARD);
+	GLStateCache::UseProgram(m_Shader->GetRendererID());
+	GLStateCache::BindVertexArray(m_VertexArray);
+
+	uint32_t quadCount = s_QuadCounts[m_QuadCount];
+	float elapsed = BenchmarkUtils::MeasureMillis([&]()
+	{
+		for (uint32_t submitted = 0; submitted < quadCount; submitted += s_ChunkQuads)
+		{
+			uint32_t offset = m_StreamBuffer->Upload(m_Staging.data(), (uint32_t)m_Staging.size());
+			glVertexArrayVertexBuffer(m_VertexArray, 0, m_StreamBuffer->GetRendererID(), offset, sizeof(QuadVertex));
+			glDrawArrays(GL_POINTS, 0, s_ChunkQuads * 4);
+			m_StreamBuffer->Fence();
+		}
+	});
+
+	GLStateCache::Disable(GL_RASTERIZER_DISCARD);
+
+	m_Frame++;
+	if (m_Frame > s_WarmupFrames)
+		m_AccumulatedMs += elapsed;
+
+	if (m_Frame < s_WarmupFrames + s_MeasuredFrames)
+		return;
+
+	m_Results[m_Strategy][m_QuadCount] = m_AccumulatedMs / s_MeasuredFrames;
+	m_AccumulatedMs = 0.0f;
+	m_Frame = 0;
+
+	// Advance to the next quad count, then the next strategy
+	if (++m_QuadCount == QuadCountCount)
+	{
+		m_QuadCount = 0;
+		m_StreamBuffer.reset();
+		if (++m_Strategy == StrategyCount)
+		{
+			m_Strategy = 0;
+			m_Running = false;
+		}
+	}
+}
+
+void StreamBufferBenchmark::OnImGuiRender()
+{
+	if (m_Running)
+	{
+		ImGui::Text("Running %s, %d quads...", StreamBuffer::GetStrategyName((StreamBufferStrategy)m_Strategy), s_QuadCounts[m_QuadCount]);
+	}
+	else if (ImGui::Button("Run"))
+	{
+		m_Running = true;
+		m_Strategy = 0;
+		m_QuadCount = 0;
+		m_Frame = 0;
+		m_AccumulatedMs = 0.0f;
+	}
+
+	ImGui::Text("CPU ms/frame (upload + draw)    10k      100k     1M");
+	for (int i = 0; i < StrategyCount; i++)
+	{
+		ImGui::Text("%-30s %8.3f %8.3f %8.3f", StreamBuffer::GetStrategyName((StreamBufferStrategy)i),
+			m_Results[i][0], m_Results[i][1], m_Results[i][2]);
+	}
+
+	int current = (int)Renderer2D::GetStreamBufferStrategy();
+	const char* names[StrategyCount];
+	for (int i = 0; i < StrategyCount; i++)
+		names[i] = StreamBuffer::GetStrategyName((StreamBufferStrategy)i);
+	if (ImGui::Combo("Renderer2D Strategy", &current, names, StrategyCount))
+		Renderer2D::SetStreamBufferStrategy((StreamBufferStrategy)current);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Benchmark.h"
+
+#include <GLCore/Renderer/StreamBuffer.h>
+
+// Uploads and draws 10k..1M quads a frame with every StreamBufferStrategy
+class StreamBufferBenchmark : public Benchmark
+{
+public:
+	StreamBufferBenchmark();
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+	virtual void OnUpdate() override;
+	virtual void OnImGuiRender() override;
+private:
+	static const int StrategyCount = 4;
+	static const int QuadCountCount = 3;
+
+	GLCore::Utils::Shader* m_Shader = nullptr;
+	GLuint m_VertexArray = 0;
+	std::unique_ptr<GLCore::StreamBuffer> m_StreamBuffer;
+	std::vector<uint8_t> m_Staging;
+
+	bool m_Running = false;
+	int m_Strategy = 0;
+	int m_QuadCount = 0;
+	int m_Frame = 0;
+	float m_AccumulatedMs = 0.0f;
+	float m_Results[StrategyCount][QuadCountCount] = {};
+};
@@ -0,0 +1,68 @@
+#include "TextureLibraryBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+TextureLibraryBenchmark::TextureLibraryBenchmark()
+	: Benchmark("Texture Library")
+{
+}
+
+void TextureLibraryBenchmark::OnDetach()
+{
+	m_Handles.clear();
+}
+
+void TextureLibraryBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Layers", &m_LayerCount, 1.0f, 1, 64);
+
+	if (ImGui::Button("Load"))
+	{
+		// Every layer loading its own copy, as with raw LoadTexture calls
+		uint32_t count = (uint32_t)m_LayerCount * BenchmarkUtils::TextureCount;
+		std::vector<GLuint> textures(count);
+		m_RawMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+				textures[i] = LoadTexture(BenchmarkUtils::TexturePaths[i % BenchmarkUtils::TextureCount]);
+		}, true);
+
+		m_RawBytes = 0;
+		for (GLuint texture : textures)
+		{
+			GLint width, height;
+			glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_WIDTH, &width);
+			glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_HEIGHT, &height);
+			m_RawBytes += (uint64_t)width * height * 3; // LoadTexture stores RGB8
+		}
+		glDeleteTextures((GLsizei)textures.size(), textures.data());
+		GLStateCache::Invalidate();
+
+		// The same requests through the library, handles are kept until released below
+		m_LibraryMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+				m_Handles.push_back(TextureLibrary::Load(BenchmarkUtils::TexturePaths[i % BenchmarkUtils::TextureCount]));
+		}, true);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Release Handles"))
+		m_Handles.clear();
+
+	int budget = (int)(TextureLibrary::GetUnusedMemoryBudget() >> 20);
+	if (ImGui::DragInt("Unused Budget (MB)", &budget, 1.0f, 0, 1024))
+		TextureLibrary::SetUnusedMemoryBudget((uint64_t)budget << 20);
+
+	if (m_RawBytes)
+	{
+		ImGui::Text("LoadTexture per layer: %8.1f ms  %8.1f MB", m_RawMs, m_RawBytes / (1024.0f * 1024.0f));
+		ImGui::Text("TextureLibrary:        %8.1f ms", m_LibraryMs);
+	}
+
+	auto& stats = TextureLibrary::GetStats();
+	ImGui::Text("Handles held: %u", (uint32_t)m_Handles.size());
+	ImGui::Text("Requests: %u, hits: %u, decodes: %u, cooked: %u, evictions: %u", stats.Requests, stats.Hits, stats.Decodes, stats.CookedLoads, stats.Evictions);
+	ImGui::Text("Resident: %u textures, %.1f MB (%u unused, %.1f MB)", stats.ResidentCount, stats.ResidentBytes / (1024.0f * 1024.0f),
+		stats.UnusedCount, stats.UnusedBytes / (1024.0f * 1024.0f));
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// The same textures requested by several simulated layers, each loading its
+// own copy against sharing them through TextureLibrary
+class TextureLibraryBenchmark : public Benchmark
+{
+public:
+	TextureLibraryBenchmark();
+
+	virtual void OnDetach() override;
+	virtual void OnImGuiRender() override;
+private:
+	int m_LayerCount = 8;
+	float m_RawMs = 0.0f;
+	float m_LibraryMs = 0.0f;
+	uint64_t m_RawBytes = 0;
+	std::vector<std::shared_ptr<GLCore::Texture2D>> m_Handles;
+};
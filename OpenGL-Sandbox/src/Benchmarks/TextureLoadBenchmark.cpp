@@ -0,0 +1,83 @@
+#include "TextureLoadBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+TextureLoadBenchmark::TextureLoadBenchmark()
+	: Benchmark("Texture Loading")
+{
+}
+
+void TextureLoadBenchmark::OnDetach()
+{
+	m_Loader.reset();
+}
+
+void TextureLoadBenchmark::Start(uint32_t threadCount)
+{
+	AsyncTextureLoaderSpecification spec;
+	spec.ThreadCount = threadCount;
+	m_Loader = std::make_unique<AsyncTextureLoader>(spec);
+	m_Frames = 0;
+	m_Timer.Reset();
+	for (int i = 0; i < m_TextureCount; i++)
+		m_Loader->Load(BenchmarkUtils::TexturePaths[i % BenchmarkUtils::TextureCount]);
+}
+
+void TextureLoadBenchmark::OnUpdate()
+{
+	if (!m_Loader)
+		return;
+
+	m_Loader->Update();
+	m_Frames++;
+	if (!m_Loader->IsIdle())
+		return;
+
+	glFinish();
+	uint32_t threads = m_Loader->GetThreadCount();
+	m_Results.push_back({ threads, m_Timer.ElapsedMillis(), m_Frames });
+
+	// Free this round's textures before the next one starts
+	m_Loader.reset();
+
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	if (threads < maxThreads)
+		Start(std::min(threads * 2, maxThreads));
+}
+
+void TextureLoadBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Textures", &m_TextureCount, 1.0f, 1, 256);
+
+	if (m_Loader)
+	{
+		ImGui::Text("Loading with %u threads, %u pending...", m_Loader->GetThreadCount(), m_Loader->GetPendingCount());
+	}
+	else if (ImGui::Button("Load"))
+	{
+		// Baseline: what a layer's OnAttach blocks for when it decodes on the GL thread
+		std::vector<GLuint> textures(m_TextureCount);
+		m_SyncMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (int i = 0; i < m_TextureCount; i++)
+				textures[i] = LoadTexture(BenchmarkUtils::TexturePaths[i % BenchmarkUtils::TextureCount]);
+		}, true);
+		glDeleteTextures((GLsizei)textures.size(), textures.data());
+		GLStateCache::Invalidate();
+
+		m_Results.clear();
+		Start(1);
+	}
+
+	if (m_Results.empty())
+		return;
+
+	ImGui::Text("Synchronous LoadTexture: %.1f ms (one blocked frame)", m_SyncMs);
+	ImGui::Text("Threads   Load ms   Speedup   Frames");
+	for (const Result& result : m_Results)
+	{
+		ImGui::Text("%7u   %7.1f   %6.2fx   %6u", result.ThreadCount, result.LoadMs,
+			m_SyncMs / result.LoadMs, result.Frames);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Synchronous LoadTexture against the async loader with 1, 2, 4, ... decode
+// threads, timed until the last texture is uploaded
+class TextureLoadBenchmark : public Benchmark
+{
+public:
+	TextureLoadBenchmark();
+
+	virtual void OnDetach() override;
+	virtual void OnUpdate() override;
+	virtual void OnImGuiRender() override;
+private:
+	void Start(uint32_t threadCount);
+private:
+	struct Result
+	{
+		uint32_t ThreadCount;
+		float LoadMs;
+		uint32_t Frames;
+	};
+
+	int m_TextureCount = 32;
+	float m_SyncMs = 0.0f;
+	std::unique_ptr<GLCore::AsyncTextureLoader> m_Loader;
+	GLCore::Utils::Timer m_Timer;
+	uint32_t m_Frames = 0;
+	std::vector<Result> m_Results;
+};
@@ -0,0 +1,73 @@
+#include "TexturePackerBenchmark.h"
+
+#include <random>
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+TexturePackerBenchmark::TexturePackerBenchmark()
+	: Benchmark("Texture Packer")
+{
+}
+
+TexturePackerBenchmark::Result TexturePackerBenchmark::Pack(const TexturePackerSpecification& spec) const
+{
+	// Fixed seed so runs with different settings see the same input
+	std::mt19937 rng(1337);
+	std::uniform_int_distribution<uint32_t> size(1, (uint32_t)m_MaxRectSize);
+
+	std::vector<PackRect> rects(m_RectCount);
+	for (PackRect& rect : rects)
+	{
+		rect.Width = size(rng);
+		rect.Height = size(rng);
+	}
+
+	TexturePacker packer(spec);
+	packer.Pack(rects);
+
+	Result result;
+	result.Stats = packer.GetStats();
+	uint32_t alignment = packer.GetSpecification().Alignment;
+	for (const PackRect& rect : rects)
+	{
+		if (rect.Page != PackRect::InvalidPage && (rect.X % alignment != 0 || rect.Y % alignment != 0))
+			result.MisalignedCount++;
+	}
+	return result;
+}
+
+void TexturePackerBenchmark::DrawResult(const char* name, const Result& result)
+{
+	const TexturePackerStats& stats = result.Stats;
+	ImGui::Text("%s", name);
+	ImGui::Text("  Pages: %d  Packed: %d  Failed: %d", stats.PageCount, stats.PackedCount, stats.FailedCount);
+	ImGui::Text("  Efficiency: %.1f%%  Build Time: %.3f ms", stats.Efficiency * 100.0f, stats.BuildTimeMs);
+	ImGui::Text("  Origins: %s", result.MisalignedCount ? "MISALIGNED" : "aligned");
+}
+
+void TexturePackerBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Rects", &m_RectCount, 10.0f, 1, 100000);
+	ImGui::DragInt("Max Rect Size", &m_MaxRectSize, 1.0f, 1, 1024);
+	ImGui::DragInt("Padding", (int*)&m_Spec.Padding, 0.1f, 0, 16);
+	ImGui::DragInt("Gutter", (int*)&m_Spec.Gutter, 0.1f, 0, 16);
+	ImGui::DragInt("Alignment", (int*)&m_Spec.Alignment, 0.1f, 1, 16);
+
+	if (ImGui::Button("Pack"))
+	{
+		m_Result = Pack(m_Spec);
+
+		TexturePackerSpecification mipSafe = m_Spec;
+		mipSafe.Gutter = 2;
+		mipSafe.Alignment = 4;
+		m_MipSafeResult = Pack(mipSafe);
+		m_Packed = true;
+	}
+
+	if (!m_Packed)
+		return;
+
+	DrawResult("Current settings", m_Result);
+	DrawResult("Gutter 2, alignment 4", m_MipSafeResult);
+}
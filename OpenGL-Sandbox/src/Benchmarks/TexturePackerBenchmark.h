@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Packs random rects with the current specification and with the mip-safe
+// setup (gutter 2, alignment 4), whose gutter is not a multiple of the
+// alignment; both check that every origin is aligned (CPU only)
+class TexturePackerBenchmark : public Benchmark
+{
+public:
+	TexturePackerBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	struct Result
+	{
+		GLCore::Utils::TexturePackerStats Stats;
+		uint32_t MisalignedCount = 0;
+	};
+
+	Result Pack(const GLCore::Utils::TexturePackerSpecification& spec) const;
+	static void DrawResult(const char* name, const Result& result);
+private:
+	GLCore::Utils::TexturePackerSpecification m_Spec;
+	int m_RectCount = 2000;
+	int m_MaxRectSize = 128;
+	Result m_Result, m_MipSafeResult;
+	bool m_Packed = false;
+};
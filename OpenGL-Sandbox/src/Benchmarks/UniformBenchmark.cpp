@@ -0,0 +1,122 @@
+#include "UniformBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+static const char* s_VertexShader = R"(
+	#version 450 core
+
+	layout (location = 0) in vec3 a_Position;
+	layout (location = 1) in vec2 a_TexCoord;
+
+	uniform mat4 u_ViewProjection;
+	uniform mat4 u_Transform;
+
+	out vec2 v_TexCoord;
+
+	void main()
+	{
+		v_TexCoord = a_TexCoord;
+		gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0f);
+	}
+)";
+
+static const char* s_FragmentShader = R"(
+	#version 450 core
+
+	layout (location = 0) out vec4 o_Color;
+
+	in vec2 v_TexCoord;
+
+	uniform vec4 u_Color;
+	uniform sampler2D u_Textures[4];
+
+	void main()
+	{
+		o_Color = texture(u_Textures[int(v_TexCoord.x * 3.0f)], v_TexCoord) * u_Color;
+	}
+)";
+
+UniformBenchmark::UniformBenchmark()
+	: Benchmark("Uniform Setters")
+{
+}
+
+void UniformBenchmark::OnDetach()
+{
+	m_Shader.reset();
+}
+
+void UniformBenchmark::OnImGuiRender()
+{
+	if (!m_Shader)
+		m_Shader = std::unique_ptr<Shader>(Shader::FromGLSLSource(s_VertexShader, s_FragmentShader));
+	GLuint program = m_Shader->GetRendererID();
+
+	ImGui::DragInt("Sets", &m_SetCount, 100.0f, 100, 1000000);
+
+	if (ImGui::Button("Run"))
+	{
+		glm::mat4 transform(1.0f);
+		glm::vec4 color(1.0f);
+
+		// What layers used to do every frame: bind, look the names up, set
+		m_ByNameMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (int i = 0; i < m_SetCount; i++)
+			{
+				transform[3][0] = (float)i;
+				GLStateCache::UseProgram(program);
+				glUniformMatrix4fv(glGetUniformLocation(program, "u_Transform"), 1, GL_FALSE, glm::value_ptr(transform));
+				glUniform4fv(glGetUniformLocation(program, "u_Color"), 1, glm::value_ptr(color));
+			}
+		}, true);
+
+		GLint transformLocation = m_Shader->GetUniformLocation("u_Transform");
+		GLint colorLocation = m_Shader->GetUniformLocation("u_Color");
+		m_ByLocationMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (int i = 0; i < m_SetCount; i++)
+			{
+				transform[3][0] = (float)i;
+				m_Shader->SetMat4(transformLocation, transform);
+				m_Shader->SetFloat4(colorLocation, color);
+			}
+		}, true);
+
+		// Same data as one std140 block per draw in the frame uniform ring
+		struct DrawUniforms
+		{
+			glm::mat4 Transform;
+			glm::vec4 Color;
+		} uniforms = { transform, color };
+		uint32_t pushCount = std::min((uint32_t)m_SetCount, FrameUniforms::MaxDrawBytesPerFrame / 256);
+		float ringMs = BenchmarkUtils::MeasureMillis([&]()
+		{
+			for (uint32_t i = 0; i < pushCount; i++)
+			{
+				uniforms.Transform[3][0] = (float)i;
+				FrameUniforms::PushDrawUniforms(&uniforms, (uint32_t)sizeof(uniforms));
+			}
+		}, true);
+		m_RingMs = ringMs * m_SetCount / pushCount;
+	}
+
+	if (m_ByNameMs > 0.0f)
+	{
+		ImGui::Text("glGetUniformLocation + glUniform: %8.2f ms", m_ByNameMs);
+		ImGui::Text("Reflected location + SetMat4:     %8.2f ms  (%.1fx)", m_ByLocationMs, m_ByNameMs / m_ByLocationMs);
+		ImGui::Text("Uniform ring + glBindBufferRange: %8.2f ms  (%.1fx)", m_RingMs, m_ByNameMs / m_RingMs);
+	}
+
+	auto& frameStats = FrameUniforms::GetStats();
+	ImGui::Text("Camera block: %u uploads, %u unchanged, %u queued snapshots this frame", frameStats.CameraUploads, frameStats.CameraSkips, frameStats.CameraSnapshots);
+	ImGui::Text("Draw blocks: %u pushes, %.1f KB this frame", frameStats.DrawPushes, frameStats.DrawBytes / 1024.0f);
+
+	ImGui::Text("Reflected uniforms:");
+	for (const ShaderUniform& uniform : m_Shader->GetUniforms())
+		ImGui::Text("  %-18s location %2d  count %2d  type 0x%04x", uniform.Name.c_str(), uniform.Location, uniform.Count, uniform.Type);
+	ImGui::Text("Reflected attributes:");
+	for (const ShaderAttribute& attribute : m_Shader->GetAttributes())
+		ImGui::Text("  %-18s location %2d  type 0x%04x", attribute.Name.c_str(), attribute.Location, attribute.Type);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Per-call name lookups against reflected locations and the frame uniform ring
+class UniformBenchmark : public Benchmark
+{
+public:
+	UniformBenchmark();
+
+	virtual void OnDetach() override;
+	virtual void OnImGuiRender() override;
+private:
+	std::unique_ptr<GLCore::Utils::Shader> m_Shader;
+	int m_SetCount = 10000;
+	float m_ByNameMs = 0.0f;
+	float m_ByLocationMs = 0.0f;
+	float m_RingMs = 0.0f;
+};
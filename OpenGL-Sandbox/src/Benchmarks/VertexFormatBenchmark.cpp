@@ -0,0 +1,43 @@
+#include "VertexFormatBenchmark.h"
+
+using namespace GLCore;
+using namespace GLCore::Utils;
+
+VertexFormatBenchmark::VertexFormatBenchmark()
+	: Benchmark("Vertex Format")
+{
+}
+
+void VertexFormatBenchmark::OnImGuiRender()
+{
+	ImGui::DragInt("Quads", &m_QuadCount, 1000.0f, 1, 2000000);
+
+	if (ImGui::Button("Fill"))
+	{
+		std::vector<uint8_t> buffer((size_t)m_QuadCount * 4 * sizeof(QuadVertex));
+		for (int f = 0; f < FormatCount; f++)
+		{
+			QuadVertexFormat format = (QuadVertexFormat)f;
+
+			uint8_t* target = buffer.data();
+			m_FillMs[f] = BenchmarkUtils::MeasureMillis([&]()
+			{
+				for (int i = 0; i < m_QuadCount; i++)
+				{
+					glm::vec3 position = { (float)(i % 512), (float)(i / 512 % 512), 0.0f };
+					target = WriteQuadVertices(format, target, position, { 1.0f, 1.0f }, { 1.0f, 0.5f, 0.25f, 1.0f },
+						(float)(i % 16), { 0.0f, 0.0f }, { 1.0f, 1.0f });
+				}
+			});
+			m_Bytes[f] = (uint32_t)(target - buffer.data());
+		}
+	}
+
+	ImGui::Text("Format        Vertex   Bytes/frame     Fill ms");
+	for (int f = 0; f < FormatCount; f++)
+	{
+		QuadVertexFormat format = (QuadVertexFormat)f;
+		ImGui::Text("%-12s  %4d B   %11u   %9.3f", GetQuadVertexFormatName(format), GetQuadVertexSize(format),
+			m_Bytes[f], m_FillMs[f]);
+	}
+}
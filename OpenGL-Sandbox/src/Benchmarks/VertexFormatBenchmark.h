@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Fill time and size of each QuadVertexFormat (CPU only)
+class VertexFormatBenchmark : public Benchmark
+{
+public:
+	VertexFormatBenchmark();
+
+	virtual void OnImGuiRender() override;
+private:
+	static const int FormatCount = 3;
+
+	int m_QuadCount = 100000;
+	float m_FillMs[FormatCount] = {};
+	uint32_t m_Bytes[FormatCount] = {};
+};
@@ -34,7 +34,7 @@ void ParticleSystem::OnUpdate(GLCore::Timestep ts)
 
 void ParticleSystem::OnRender(GLCore::Utils::OrthographicCamera& camera)
 {
-	if (m_QuadVA == 0)
+	if (!m_QuadVA)
 	{
 		// create render state
 		float vertices[] = {
@@ -44,34 +44,32 @@ void ParticleSystem::OnRender(GLCore::Utils::OrthographicCamera& camera)
 			-0.5f,  0.5f, 0.0f
 		};
 
-		glCreateVertexArrays(1, &m_QuadVA);
-		glBindVertexArray(m_QuadVA);
-
-		GLuint quadVB;
-		glCreateBuffers(1, &quadVB);
-		glBindBuffer(GL_ARRAY_BUFFER, quadVB);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-		glEnableVertexArrayAttrib(quadVB, 0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, 0);
+		auto quadVB = std::make_shared<GLCore::VertexBuffer>(vertices, (uint32_t)sizeof(vertices));
+		quadVB->SetLayout({
+			{ GLCore::VertexElementType::Float3, "a_Position" }
+		});
 
 		uint32_t indices[] = {
 			0, 1, 2, 2, 3, 0
 		};
 
-		GLuint quadIB;
-		glCreateBuffers(1, &quadIB);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIB);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+		m_QuadVA = std::make_unique<GLCore::VertexArray>();
+		m_QuadVA->AddVertexBuffer(quadVB);
+		m_QuadVA->SetIndexBuffer(std::make_shared<GLCore::IndexBuffer>(indices, 6));
 
 		m_ParticleShader = std::unique_ptr<GLCore::Utils::Shader>(GLCore::Utils::Shader::FromGLSLTextFiles("assets/shaders/particle.vert.glsl", "assets/shaders/particle.frag.glsl"));
-		m_ParticleShaderViewProjection = glGetUniformLocation(m_ParticleShader->GetRendererID(), "u_ViewProjection");
-		m_ParticleShaderTransform = glGetUniformLocation(m_ParticleShader->GetRendererID(), "u_Transform");
-		m_ParticleShaderColor = glGetUniformLocation(m_ParticleShader->GetRendererID(), "u_Color");
+
+		// per-particle transform and color come from the render queue's draw data, so all particles go out in one multi-draw
+		GLCore::RenderQueue::AttachDrawIndex(m_QuadVA->GetRendererID(), 1, m_QuadVA->GetNextBinding()); // a_DrawIndex is location 1
 	}
 
-	glUseProgram(m_ParticleShader->GetRendererID());
-	glUniformMatrix4fv(m_ParticleShaderViewProjection, 1, GL_FALSE, glm::value_ptr(camera.GetViewProjectionMatrix()));
+	GLCore::FrameUniforms::SetCamera(camera);
+
+	GLCore::DrawCommand command;
+	command.Shader = m_ParticleShader->GetRendererID();
+	command.VertexArray = m_QuadVA->GetRendererID();
+	command.Count = 6;
+	command.UseDrawData = true;
 
 	for (Particle& particle : m_ParticlePool)
 	{
@@ -92,10 +90,10 @@ void ParticleSystem::OnRender(GLCore::Utils::OrthographicCamera& camera)
 		transform = glm::rotate(transform, particle.Rotation, { 0.f, 0.f, 1.f });
 		transform = glm::scale(transform, { size, size, 1.f });
 
-		glUniformMatrix4fv(m_ParticleShaderTransform, 1, GL_FALSE, glm::value_ptr(transform));
-		glUniform4fv(m_ParticleShaderColor, 1, glm::value_ptr(color));
-		glBindVertexArray(m_QuadVA);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		// particles blend, so sort them back to front: the youngest are drawn on top
+		command.Transform = transform;
+		command.Color = color;
+		GLCore::RenderQueue::Submit(command, 0, true, 1.f - life);
 	}
 }
 
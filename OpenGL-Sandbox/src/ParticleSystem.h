@@ -45,11 +45,6 @@ private:
 	std::vector<Particle> m_ParticlePool;
 	int32_t m_PoolIndex = 999;
 
-	GLuint m_QuadVA = 0;
+	std::unique_ptr<GLCore::VertexArray> m_QuadVA;
 	std::unique_ptr<GLCore::Utils::Shader> m_ParticleShader;
-
-	// uniform locations
-	GLint m_ParticleShaderViewProjection;
-	GLint m_ParticleShaderTransform;
-	GLint m_ParticleShaderColor;
 };
\ No newline at end of file
@@ -19,8 +19,8 @@ void ParticleSystemLayer::OnAttach()
 {
 	EnableGLDebugging();
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLStateCache::Enable(GL_BLEND);
+	GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	m_Particle.ColorBegin = { 254 / 255.f, 212 / 255.f, 123 / 255.f, 1.f };
 	m_Particle.ColorEnd = { 254 / 255.f, 109 / 255.f, 41 / 255.f, 1.f };
@@ -89,5 +89,18 @@ void ParticleSystemLayer::OnImGuiRender()
 	ImGui::ColorEdit4("Birth Color", glm::value_ptr(m_Particle.ColorBegin));
 	ImGui::ColorEdit4("Death Color", glm::value_ptr(m_Particle.ColorEnd));
 	ImGui::DragFloat("Life Time", &m_Particle.LifeTime, 0.1, 0.f, 1000.f);
+
+	auto& stats = RenderQueue::GetStats();
+	ImGui::Text("Render Queue Stats:");
+	ImGui::Text("Commands: %d", stats.Commands);
+	ImGui::Text("Program Binds: %d", stats.ProgramBinds);
+	ImGui::Text("Vertex Array Binds: %d", stats.VertexArrayBinds);
+	ImGui::Text("Camera Binds: %d", stats.CameraBinds);
+	ImGui::Text("Draw Calls: %d (%d multi-draws)", stats.DrawCalls, stats.MultiDraws);
+
+	bool forceFallback = MultiDrawIndirect::IsFallbackForced();
+	if (ImGui::Checkbox("Force Draw Loop", &forceFallback))
+		MultiDrawIndirect::SetForceFallback(forceFallback);
+	ImGui::Text("Sort: %.3f ms", stats.SortTimeMs);
 	ImGui::End();
 }
@@ -2,6 +2,24 @@
 #include "BatchRenderingLayer.h"
 #include "ParticleSystemLayer.h"
 #include "SandboxLayer.h"
+#include "BenchmarkLayer.h"
+
+#include "Benchmarks/StreamBufferBenchmark.h"
+#include "Benchmarks/TexturePackerBenchmark.h"
+#include "Benchmarks/VertexFormatBenchmark.h"
+#include "Benchmarks/QuadKernelBenchmark.h"
+#include "Benchmarks/ParallelBuildBenchmark.h"
+#include "Benchmarks/SortBenchmark.h"
+#include "Benchmarks/CullingBenchmark.h"
+#include "Benchmarks/TextureLoadBenchmark.h"
+#include "Benchmarks/TextureLibraryBenchmark.h"
+#include "Benchmarks/CookedTextureBenchmark.h"
+#include "Benchmarks/AssetPackBenchmark.h"
+#include "Benchmarks/ShaderCacheBenchmark.h"
+#include "Benchmarks/ShaderHotReloadPanel.h"
+#include "Benchmarks/ShaderVariantBenchmark.h"
+#include "Benchmarks/ShaderWarmupBenchmark.h"
+#include "Benchmarks/UniformBenchmark.h"
 
 using namespace GLCore;
 
@@ -10,8 +28,30 @@ class Sandbox : public Application
 public:
 	Sandbox()
 	{
+		// Built by the prebuild step; without it every asset is read from its loose file
+		AssetPack::Mount("assets.pak");
+
 		PushLayer(new BatchRenderingLayer());
 		//PushLayer(new ParticleSystemLayer());
+
+		BenchmarkLayer* benchmarks = new BenchmarkLayer();
+		benchmarks->AddBenchmark<StreamBufferBenchmark>();
+		benchmarks->AddBenchmark<TexturePackerBenchmark>();
+		benchmarks->AddBenchmark<VertexFormatBenchmark>();
+		benchmarks->AddBenchmark<QuadKernelBenchmark>();
+		benchmarks->AddBenchmark<ParallelBuildBenchmark>();
+		benchmarks->AddBenchmark<SortBenchmark>();
+		benchmarks->AddBenchmark<CullingBenchmark>();
+		benchmarks->AddBenchmark<TextureLoadBenchmark>();
+		benchmarks->AddBenchmark<TextureLibraryBenchmark>();
+		benchmarks->AddBenchmark<CookedTextureBenchmark>();
+		benchmarks->AddBenchmark<AssetPackBenchmark>();
+		benchmarks->AddBenchmark<ShaderCacheBenchmark>();
+		benchmarks->AddBenchmark<ShaderHotReloadPanel>();
+		benchmarks->AddBenchmark<ShaderVariantBenchmark>();
+		benchmarks->AddBenchmark<ShaderWarmupBenchmark>();
+		benchmarks->AddBenchmark<UniformBenchmark>();
+		PushLayer(benchmarks);
 	}
 };
 
@@ -19,4 +59,4 @@ int main()
 {
 	std::unique_ptr<Sandbox> app = std::make_unique<Sandbox>();
 	app->Run();
-}
\ No newline at end of file
+}
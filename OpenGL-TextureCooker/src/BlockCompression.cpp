@@ -0,0 +1,538 @@
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+using namespace GLCore::Utils;
+
+// Principal axis of count points of dimension N (power iteration on the covariance)
+template<int N>
+static void FindPrincipalAxis(const float (*points)[4], int count, float* mean, float* axis)
+{
+	for (int c = 0; c < N; c++)
+	{
+		mean[c] = 0.0f;
+		for (int i = 0; i < count; i++)
+			mean[c] += points[i][c];
+		mean[c] /= (float)count;
+	}
+
+	float covariance[N][N] = {};
+	for (int i = 0; i < count; i++)
+	{
+		for (int a = 0; a < N; a++)
+			for (int b = 0; b < N; b++)
+				covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+	}
+
+	for (int c = 0; c < N; c++)
+		axis[c] = 1.0f;
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float next[N] = {};
+		for (int a = 0; a < N; a++)
+			for (int b = 0; b < N; b++)
+				next[a] += covariance[a][b] * axis[b];
+
+		float length = 0.0f;
+		for (int c = 0; c < N; c++)
+			length += next[c] * next[c];
+		if (length < 1e-12f)
+			break; // flat block, any axis will do
+		length = std::sqrt(length);
+		for (int c = 0; c < N; c++)
+			axis[c] = next[c] / length;
+	}
+}
+
+// Endpoints at the extremes of the points projected onto the principal axis
+template<int N>
+static void FindEndpoints(const float (*points)[4], int count, float* endpoint0, float* endpoint1)
+{
+	float mean[N], axis[N];
+	FindPrincipalAxis<N>(points, count, mean, axis);
+
+	float minT = 0.0f, maxT = 0.0f;
+	for (int i = 0; i < count; i++)
+	{
+		float t = 0.0f;
+		for (int c = 0; c < N; c++)
+			t += (points[i][c] - mean[c]) * axis[c];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+
+	for (int c = 0; c < N; c++)
+	{
+		endpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+		endpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+	}
+}
+
+// Least squares endpoints for fixed interpolation weights (0 = endpoint0, 1 = endpoint1).
+// Returns false if all weights are equal and the system is singular.
+template<int N>
+static bool SolveEndpoints(const float (*points)[4], const float* weights, int count, float* endpoint0, float* endpoint1)
+{
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ap[N] = {}, bp[N] = {};
+	for (int i = 0; i < count; i++)
+	{
+		float b = weights[i], a = 1.0f - b;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = 0; c < N; c++)
+		{
+			ap[c] += a * points[i][c];
+			bp[c] += b * points[i][c];
+		}
+	}
+
+	float determinant = aa * bb - ab * ab;
+	if (std::abs(determinant) < 1e-6f)
+		return false;
+
+	for (int c = 0; c < N; c++)
+	{
+		endpoint0[c] = std::clamp((ap[c] * bb - bp[c] * ab) / determinant, 0.0f, 255.0f);
+		endpoint1[c] = std::clamp((bp[c] * aa - ap[c] * ab) / determinant, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+static float ColorError(const float* a, const float* b, int channels)
+{
+	float error = 0.0f;
+	for (int c = 0; c < channels; c++)
+		error += (a[c] - b[c]) * (a[c] - b[c]);
+	return error;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// BC1 ///////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+static uint16_t PackRGB565(const float* color)
+{
+	uint32_t r = (uint32_t)std::lround(color[0] * 31.0f / 255.0f);
+	uint32_t g = (uint32_t)std::lround(color[1] * 63.0f / 255.0f);
+	uint32_t b = (uint32_t)std::lround(color[2] * 31.0f / 255.0f);
+	return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(uint16_t packed, float* color)
+{
+	uint32_t r = packed >> 11, g = (packed >> 5) & 63, b = packed & 31;
+	color[0] = (float)((r << 3) | (r >> 2));
+	color[1] = (float)((g << 2) | (g >> 4));
+	color[2] = (float)((b << 3) | (b >> 2));
+}
+
+// Palette as decoded by the GPU; index 3 of the 3 color mode is transparent black
+static void BuildBC1Palette(uint16_t color0, uint16_t color1, bool threeColor, float (*palette)[4])
+{
+	UnpackRGB565(color0, palette[0]);
+	UnpackRGB565(color1, palette[1]);
+	for (int c = 0; c < 3; c++)
+	{
+		if (threeColor)
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+			palette[3][c] = 0.0f;
+		}
+		else
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+	}
+}
+
+// Returns the squared error of the best indices into palette for the opaque texels
+static float AssignBC1Indices(const float (*points)[4], const bool* transparent, const float (*palette)[4], bool threeColor, uint8_t* indices)
+{
+	float totalError = 0.0f;
+	for (int i = 0; i < 16; i++)
+	{
+		if (transparent[i])
+		{
+			indices[i] = 3;
+			continue;
+		}
+
+		float bestError = FLT_MAX;
+		for (int j = 0; j < (threeColor ? 3 : 4); j++)
+		{
+			float error = ColorError(points[i], palette[j], 3);
+			if (error < bestError)
+			{
+				bestError = error;
+				indices[i] = (uint8_t)j;
+			}
+		}
+		totalError += bestError;
+	}
+	return totalError;
+}
+
+static void EncodeBC1(const uint8_t* texels, uint8_t* target, bool punchThrough, bool forceFourColor)
+{
+	float points[16][4];
+	bool transparent[16];
+	float opaquePoints[16][4];
+	int opaqueCount = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++)
+			points[i][c] = texels[i * 4 + c];
+		transparent[i] = punchThrough && !forceFourColor && texels[i * 4 + 3] < 128;
+		if (!transparent[i])
+			memcpy(opaquePoints[opaqueCount++], points[i], sizeof(points[i]));
+	}
+
+	if (opaqueCount == 0)
+	{
+		// color0 <= color1 selects the 3 color mode, every index 3 is transparent black
+		memset(target, 0, 4);
+		memset(target + 4, 0xff, 4);
+		return;
+	}
+
+	const bool threeColor = opaqueCount < 16;
+
+	float endpoint0[3], endpoint1[3];
+	FindEndpoints<3>(opaquePoints, opaqueCount, endpoint0, endpoint1);
+
+	uint16_t bestColor0 = 0, bestColor1 = 0;
+	uint8_t bestIndices[16] = {};
+	float bestError = FLT_MAX;
+
+	// First pass from the principal axis, then refine with least squares on the resulting indices
+	for (int pass = 0; pass < 3; pass++)
+	{
+		uint16_t color0 = PackRGB565(endpoint0), color1 = PackRGB565(endpoint1);
+
+		// The mode is chosen by the endpoint order
+		if (threeColor ? color0 > color1 : color0 < color1)
+			std::swap(color0, color1);
+
+		float palette[4][4];
+		BuildBC1Palette(color0, color1, threeColor, palette);
+
+		uint8_t indices[16];
+		float error = AssignBC1Indices(points, transparent, palette, threeColor, indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			bestColor0 = color0;
+			bestColor1 = color1;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+
+		// Interpolation weight of each palette entry towards color1
+		static const float s_FourColorWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		static const float s_ThreeColorWeights[3] = { 0.0f, 1.0f, 0.5f };
+
+		float weights[16];
+		int count = 0;
+		float solvePoints[16][4];
+		for (int i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+				continue;
+			weights[count] = threeColor ? s_ThreeColorWeights[indices[i]] : s_FourColorWeights[indices[i]];
+			memcpy(solvePoints[count++], points[i], sizeof(points[i]));
+		}
+
+		float solved0[3], solved1[3];
+		if (!SolveEndpoints<3>(solvePoints, weights, count, solved0, solved1))
+			break;
+
+		// Weights are relative to the (possibly swapped) palette, so the solve is in palette order
+		memcpy(endpoint0, solved0, sizeof(solved0));
+		memcpy(endpoint1, solved1, sizeof(solved1));
+	}
+
+	// In 4 color mode color0 == color1 would be read as 3 color mode; index 0 is right in both
+	if (!threeColor && bestColor0 == bestColor1)
+		memset(bestIndices, 0, sizeof(bestIndices));
+
+	uint32_t packedIndices = 0;
+	for (int i = 0; i < 16; i++)
+		packedIndices |= (uint32_t)bestIndices[i] << (i * 2);
+
+	target[0] = (uint8_t)bestColor0;
+	target[1] = (uint8_t)(bestColor0 >> 8);
+	target[2] = (uint8_t)bestColor1;
+	target[3] = (uint8_t)(bestColor1 >> 8);
+	memcpy(target + 4, &packedIndices, 4);
+}
+
+void CompressBC1Block(const uint8_t* texels, uint8_t* target, bool punchThrough)
+{
+	EncodeBC1(texels, target, punchThrough, false);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// BC3 ///////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+void CompressBC3Block(const uint8_t* texels, uint8_t* target)
+{
+	uint8_t alpha0 = 0, alpha1 = 255;
+	for (int i = 0; i < 16; i++)
+	{
+		alpha0 = std::max(alpha0, texels[i * 4 + 3]);
+		alpha1 = std::min(alpha1, texels[i * 4 + 3]);
+	}
+
+	// alpha0 > alpha1 selects 8 interpolated values; equal endpoints only need index 0
+	uint64_t packedIndices = 0;
+	if (alpha0 > alpha1)
+	{
+		float palette[8];
+		palette[0] = alpha0;
+		palette[1] = alpha1;
+		for (int i = 1; i < 7; i++)
+			palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7.0f;
+
+		for (int i = 0; i < 16; i++)
+		{
+			float value = texels[i * 4 + 3];
+			uint64_t best = 0;
+			for (int j = 1; j < 8; j++)
+			{
+				if (std::abs(palette[j] - value) < std::abs(palette[best] - value))
+					best = j;
+			}
+			packedIndices |= best << (i * 3);
+		}
+	}
+
+	target[0] = alpha0;
+	target[1] = alpha1;
+	for (int i = 0; i < 6; i++)
+		target[2 + i] = (uint8_t)(packedIndices >> (i * 8));
+
+	// The color block of BC3 is always decoded in 4 color mode
+	EncodeBC1(texels, target + 8, false, true);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// BC7 ///////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+static const int s_BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct BC7Endpoint
+{
+	uint8_t Color[4]; // 7 bits per channel
+	uint8_t PBit;
+
+	void Decode(float* color) const
+	{
+		for (int c = 0; c < 4; c++)
+			color[c] = (float)((Color[c] << 1) | PBit);
+	}
+};
+
+// Picks the p-bit that keeps the quantized endpoint closest to value
+static BC7Endpoint QuantizeBC7Endpoint(const float* value)
+{
+	BC7Endpoint best = {};
+	float bestError = FLT_MAX;
+	for (uint8_t pBit = 0; pBit < 2; pBit++)
+	{
+		BC7Endpoint endpoint;
+		endpoint.PBit = pBit;
+		float error = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			endpoint.Color[c] = (uint8_t)std::clamp((int)std::lround((value[c] - pBit) / 2.0f), 0, 127);
+			float decoded = (float)((endpoint.Color[c] << 1) | pBit);
+			error += (decoded - value[c]) * (decoded - value[c]);
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+			best = endpoint;
+		}
+	}
+	return best;
+}
+
+static float AssignBC7Indices(const float (*points)[4], const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, uint8_t* indices)
+{
+	float color0[4], color1[4];
+	endpoint0.Decode(color0);
+	endpoint1.Decode(color1);
+
+	float palette[16][4];
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++)
+			palette[i][c] = (float)(((64 - s_BC7Weights4[i]) * (int)color0[c] + s_BC7Weights4[i] * (int)color1[c] + 32) >> 6);
+	}
+
+	float totalError = 0.0f;
+	for (int i = 0; i < 16; i++)
+	{
+		float bestError = FLT_MAX;
+		for (int j = 0; j < 16; j++)
+		{
+			float error = ColorError(points[i], palette[j], 4);
+			if (error < bestError)
+			{
+				bestError = error;
+				indices[i] = (uint8_t)j;
+			}
+		}
+		totalError += bestError;
+	}
+	return totalError;
+}
+
+class BlockBitWriter
+{
+public:
+	BlockBitWriter(uint8_t* target)
+		: m_Target(target)
+	{
+		memset(m_Target, 0, 16);
+	}
+
+	// Least significant bit first, as BC7 is specified
+	void Write(uint32_t value, uint32_t bitCount)
+	{
+		for (uint32_t i = 0; i < bitCount; i++, m_Position++)
+		{
+			if (value & (1u << i))
+				m_Target[m_Position / 8] |= (uint8_t)(1u << (m_Position % 8));
+		}
+	}
+private:
+	uint8_t* m_Target;
+	uint32_t m_Position = 0;
+};
+
+void CompressBC7Block(const uint8_t* texels, uint8_t* target)
+{
+	float points[16][4];
+	for (int i = 0; i < 16; i++)
+		for (int c = 0; c < 4; c++)
+			points[i][c] = texels[i * 4 + c];
+
+	float value0[4], value1[4];
+	FindEndpoints<4>(points, 16, value0, value1);
+
+	BC7Endpoint best0 = {}, best1 = {};
+	uint8_t bestIndices[16] = {};
+	float bestError = FLT_MAX;
+
+	for (int pass = 0; pass < 3; pass++)
+	{
+		BC7Endpoint endpoint0 = QuantizeBC7Endpoint(value0);
+		BC7Endpoint endpoint1 = QuantizeBC7Endpoint(value1);
+
+		uint8_t indices[16];
+		float error = AssignBC7Indices(points, endpoint0, endpoint1, indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			best0 = endpoint0;
+			best1 = endpoint1;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+			weights[i] = s_BC7Weights4[indices[i]] / 64.0f;
+		if (!SolveEndpoints<4>(points, weights, 16, value0, value1))
+			break;
+	}
+
+	// The anchor index (texel 0) is stored without its top bit, so it has to be < 8
+	if (bestIndices[0] >= 8)
+	{
+		std::swap(best0, best1);
+		for (int i = 0; i < 16; i++)
+			bestIndices[i] = (uint8_t)(15 - bestIndices[i]);
+	}
+
+	BlockBitWriter writer(target);
+	writer.Write(1 << 6, 7); // mode 6
+	for (int c = 0; c < 4; c++)
+	{
+		writer.Write(best0.Color[c], 7);
+		writer.Write(best1.Color[c], 7);
+	}
+	writer.Write(best0.PBit, 1);
+	writer.Write(best1.PBit, 1);
+	writer.Write(bestIndices[0], 3);
+	for (int i = 1; i < 16; i++)
+		writer.Write(bestIndices[i], 4);
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+std::vector<uint8_t> CompressImage(const Image& image, CookedTextureFormat format)
+{
+	if (format == CookedTextureFormat::RGBA8)
+		return image.Pixels;
+
+	const uint32_t blocksX = (image.Width + 3) / 4;
+	const uint32_t blocksY = (image.Height + 3) / 4;
+	const uint32_t blockSize = format == CookedTextureFormat::BC1 ? 8 : 16;
+
+	// Punch-through only where the image actually has cut-out alpha
+	bool hasAlpha = false;
+	for (size_t i = 3; i < image.Pixels.size(); i += 4)
+		hasAlpha |= image.Pixels[i] < 255;
+
+	std::vector<uint8_t> blocks((size_t)blocksX * blocksY * blockSize);
+
+	auto compressRows = [&](uint32_t firstRow, uint32_t rowStep)
+	{
+		uint8_t texels[64];
+		for (uint32_t by = firstRow; by < blocksY; by += rowStep)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					uint32_t sourceY = std::min(by * 4 + y, image.Height - 1);
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						uint32_t sourceX = std::min(bx * 4 + x, image.Width - 1);
+						memcpy(&texels[(y * 4 + x) * 4], &image.Pixels[((size_t)sourceY * image.Width + sourceX) * 4], 4);
+					}
+				}
+
+				uint8_t* target = &blocks[((size_t)by * blocksX + bx) * blockSize];
+				switch (format)
+				{
+				case CookedTextureFormat::BC1: CompressBC1Block(texels, target, hasAlpha); break;
+				case CookedTextureFormat::BC3: CompressBC3Block(texels, target); break;
+				case CookedTextureFormat::BC7: CompressBC7Block(texels, target); break;
+				default: break;
+				}
+			}
+		}
+	};
+
+	// Interleaved block rows keep the threads evenly loaded
+	uint32_t threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), blocksY));
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < threadCount; i++)
+		threads.emplace_back(compressRows, i, threadCount);
+	compressRows(0, threadCount);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return blocks;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <GLCore/Util/Texture.h>
+#include <GLCore/Util/CookedTexture.h>
+
+// Encoders for one 4x4 block of RGBA8 texels (row by row, 64 bytes).
+// Endpoints come from the principal axis of the block's colors and are
+// refined with a least squares pass; good quality for sprites, far from the
+// exhaustive searches of dedicated compressors.
+
+// 8 bytes. With punchThrough, blocks with alpha < 128 use the 3 color mode and
+// encode those texels as transparent black.
+void CompressBC1Block(const uint8_t* texels, uint8_t* target, bool punchThrough);
+// 16 bytes: interpolated alpha block followed by a BC1 color block
+void CompressBC3Block(const uint8_t* texels, uint8_t* target);
+// 16 bytes, always mode 6 (one subset, RGBA 7.7.7.7 endpoints with p-bits, 4 bit indices)
+void CompressBC7Block(const uint8_t* texels, uint8_t* target);
+
+// Encodes a whole level (edge blocks repeat the last row/column) on all cores.
+// RGBA8 returns the pixels unchanged.
+std::vector<uint8_t> CompressImage(const GLCore::Utils::Image& image, GLCore::Utils::CookedTextureFormat format);
@@ -0,0 +1,83 @@
+#include "Mipmaps.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace GLCore::Utils;
+
+static float SRGBToLinear(float value)
+{
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSRGB(float value)
+{
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t ToUnorm8(float value)
+{
+	return (uint8_t)std::clamp((int)std::lround(value * 255.0f), 0, 255);
+}
+
+static Image Downsample(const Image& source, const float* linearTable)
+{
+	Image image;
+	image.Width = std::max(1u, source.Width / 2);
+	image.Height = std::max(1u, source.Height / 2);
+	image.Channels = 4;
+	image.Pixels.resize((size_t)image.Width * image.Height * 4);
+
+	for (uint32_t y = 0; y < image.Height; y++)
+	{
+		// Odd sizes: the last texel of each row/column folds into the last target texel
+		uint32_t y0 = y * source.Height / image.Height;
+		uint32_t y1 = (y + 1) * source.Height / image.Height;
+
+		for (uint32_t x = 0; x < image.Width; x++)
+		{
+			uint32_t x0 = x * source.Width / image.Width;
+			uint32_t x1 = (x + 1) * source.Width / image.Width;
+
+			float color[3] = {}, alpha = 0.0f, unweighted[3] = {};
+			for (uint32_t sy = y0; sy < y1; sy++)
+			{
+				for (uint32_t sx = x0; sx < x1; sx++)
+				{
+					const uint8_t* texel = &source.Pixels[((size_t)sy * source.Width + sx) * 4];
+					float a = texel[3] / 255.0f;
+					for (int c = 0; c < 3; c++)
+					{
+						color[c] += linearTable[texel[c]] * a;
+						unweighted[c] += linearTable[texel[c]];
+					}
+					alpha += a;
+				}
+			}
+
+			const float count = (float)((y1 - y0) * (x1 - x0));
+			uint8_t* target = &image.Pixels[((size_t)y * image.Width + x) * 4];
+			for (int c = 0; c < 3; c++)
+			{
+				// Fully transparent areas keep their color so later levels (and bilinear filtering) still see it
+				float linear = alpha > 0.0f ? color[c] / alpha : unweighted[c] / count;
+				target[c] = ToUnorm8(LinearToSRGB(linear));
+			}
+			target[3] = ToUnorm8(alpha / count);
+		}
+	}
+	return image;
+}
+
+std::vector<Image> GenerateMipChain(const Image& image)
+{
+	float linearTable[256];
+	for (int i = 0; i < 256; i++)
+		linearTable[i] = SRGBToLinear(i / 255.0f);
+
+	std::vector<Image> levels;
+	levels.push_back(image);
+	while (levels.back().Width > 1 || levels.back().Height > 1)
+		levels.push_back(Downsample(levels.back(), linearTable));
+	return levels;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <GLCore/Util/Texture.h>
+
+// Full mip chain of an RGBA8 image down to 1x1, level 0 included. Each level
+// is a box filter of the previous one done in linear space, weighted by alpha
+// so transparent texels do not darken the edges of sprites.
+std::vector<GLCore::Utils::Image> GenerateMipChain(const GLCore::Utils::Image& image);
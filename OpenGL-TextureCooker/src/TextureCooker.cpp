@@ -0,0 +1,207 @@
+#include <GLCore/Core/Log.h>
+
+#include "BlockCompression.h"
+#include "Mipmaps.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace GLCore::Utils;
+namespace fs = std::filesystem;
+
+// Usage: OpenGL-TextureCooker <input file|dir> <output dir> [--format auto|rgba8|bc1|bc3|bc7] [--no-mips] [--force]
+//
+// Turns .png/.jpg/.tga/.bmp images into .gltex files (see GLCore/Util/CookedTexture.h)
+// with every mip level precomputed and optionally block compressed, so the runtime
+// only has to hand the bytes to the driver. Outputs newer than their input are skipped.
+
+struct CookOptions
+{
+	bool AutoFormat = true;
+	CookedTextureFormat Format = CookedTextureFormat::BC7;
+	bool GenerateMips = true;
+	bool Force = false;
+};
+
+static const size_t s_PayloadAlignment = 16;
+
+static bool IsImageFile(const fs::path& path)
+{
+	std::string extension = path.extension().string();
+	for (char& c : extension)
+		c = (char)tolower(c);
+	return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+}
+
+static bool ParseFormat(const char* name, CookOptions& options)
+{
+	options.AutoFormat = strcmp(name, "auto") == 0;
+	if (options.AutoFormat)
+		return true;
+
+	for (CookedTextureFormat format : { CookedTextureFormat::RGBA8, CookedTextureFormat::BC1, CookedTextureFormat::BC3, CookedTextureFormat::BC7 })
+	{
+		std::string formatName = GetCookedTextureFormatName(format);
+		for (char& c : formatName)
+			c = (char)tolower(c);
+		if (formatName == name)
+		{
+			options.Format = format;
+			return true;
+		}
+	}
+	return false;
+}
+
+// BC1 for opaque images (half the size of BC3), BC3 for anything with alpha.
+// The BC7 encoder only does mode 6, whose shared RGBA endpoints band on
+// sprites with hard alpha edges where BC3's separate alpha block does not.
+static CookedTextureFormat ChooseFormat(const Image& image)
+{
+	for (size_t i = 3; i < image.Pixels.size(); i += 4)
+	{
+		if (image.Pixels[i] != 255)
+			return CookedTextureFormat::BC3;
+	}
+	return CookedTextureFormat::BC1;
+}
+
+static bool CookTexture(const fs::path& input, const fs::path& output, const CookOptions& options)
+{
+	std::error_code error;
+	if (!options.Force && fs::exists(output, error) && fs::last_write_time(output, error) >= fs::last_write_time(input, error))
+	{
+		LOG_TRACE("{0} is up to date", output.string());
+		return true;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	Image image = Image::FromFile(input.string());
+	if (!image.IsValid())
+		return false;
+
+	std::vector<Image> levels;
+	if (options.GenerateMips)
+		levels = GenerateMipChain(image);
+	else
+		levels.push_back(image);
+
+	CookedTextureHeader header;
+	header.Format = options.AutoFormat ? ChooseFormat(image) : options.Format;
+	header.Width = image.Width;
+	header.Height = image.Height;
+	header.LevelCount = (uint32_t)levels.size();
+
+	std::vector<CookedTextureLevel> levelTable(levels.size());
+	std::vector<std::vector<uint8_t>> payloads(levels.size());
+	uint64_t offset = sizeof(header) + levelTable.size() * sizeof(CookedTextureLevel);
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		offset = (offset + s_PayloadAlignment - 1) & ~(uint64_t)(s_PayloadAlignment - 1);
+
+		payloads[i] = CompressImage(levels[i], header.Format);
+		levelTable[i] = { levels[i].Width, levels[i].Height, offset, payloads[i].size() };
+		offset += payloads[i].size();
+	}
+
+	fs::create_directories(output.parent_path(), error);
+	std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		LOG_ERROR("Could not open '{0}' for writing", output.string());
+		return false;
+	}
+
+	stream.write((const char*)&header, sizeof(header));
+	stream.write((const char*)levelTable.data(), levelTable.size() * sizeof(CookedTextureLevel));
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		static const char s_Padding[s_PayloadAlignment] = {};
+		stream.write(s_Padding, levelTable[i].Offset - (uint64_t)stream.tellp());
+		stream.write((const char*)payloads[i].data(), payloads[i].size());
+	}
+
+	if (!stream)
+	{
+		LOG_ERROR("Could not write '{0}'", output.string());
+		return false;
+	}
+
+	float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LOG_INFO("{0} -> {1}: {2}x{3} {4}, {5} levels, {6} KB (RGBA8 {7} KB), {8:.1f} ms",
+		input.filename().string(), output.string(), header.Width, header.Height, GetCookedTextureFormatName(header.Format),
+		header.LevelCount, offset / 1024, image.Pixels.size() / 1024, milliseconds);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	GLCore::Log::Init();
+
+	CookOptions options;
+	std::vector<const char*> paths;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+		{
+			if (!ParseFormat(argv[++i], options))
+			{
+				LOG_ERROR("Unknown format '{0}'", argv[i]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--no-mips") == 0)
+			options.GenerateMips = false;
+		else if (strcmp(argv[i], "--force") == 0)
+			options.Force = true;
+		else
+			paths.push_back(argv[i]);
+	}
+
+	if (paths.size() != 2)
+	{
+		LOG_ERROR("Usage: OpenGL-TextureCooker <input file|dir> <output dir> [--format auto|rgba8|bc1|bc3|bc7] [--no-mips] [--force]");
+		return 1;
+	}
+
+	const fs::path input = paths[0];
+	const fs::path outputDirectory = paths[1];
+
+	std::vector<fs::path> inputs;
+	std::error_code error;
+	if (fs::is_directory(input, error))
+	{
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error))
+		{
+			if (entry.is_regular_file() && IsImageFile(entry.path()))
+				inputs.push_back(entry.path());
+		}
+	}
+	else if (fs::is_regular_file(input, error))
+		inputs.push_back(input);
+	else
+	{
+		LOG_ERROR("'{0}' does not exist", input.string());
+		return 1;
+	}
+
+	int failures = 0;
+	for (const fs::path& path : inputs)
+	{
+		// Directories keep their layout below the output directory
+		fs::path relative = fs::is_directory(input, error) ? fs::relative(path, input, error) : path.filename();
+		fs::path output = outputDirectory / relative;
+		output.replace_extension(".gltex");
+
+		if (!CookTexture(path, output, options))
+		{
+			LOG_ERROR("Failed to cook '{0}'", path.string());
+			failures++;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -34,6 +34,11 @@ group ""
 include "OpenGL-Core"
 include "OpenGL-Sandbox"
 
+group "Tools"
+	include "OpenGL-TextureCooker"
+	include "OpenGL-AssetPacker"
+group ""
+
 -- OpenGL-Examples
 workspace "OpenGL-Examples"
     startproject "OpenGL-Examples"